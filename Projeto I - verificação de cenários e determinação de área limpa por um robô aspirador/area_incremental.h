@@ -0,0 +1,351 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef AREA_INCREMENTAL_H
+#define AREA_INCREMENTAL_H
+
+#include <charconv>  // std::from_chars
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint32_t, std::int64_t
+#include <string_view>
+#include <vector>
+
+#include "grid.h"
+#include "rotulacao.h"
+#include "uniao_busca.h"
+#include "vizinhanca.h"
+
+//! Edição de uma célula: set(x, y, 1) a libera, set(x, y, 0) a ocupa
+struct Edicao {
+    std::size_t x = 0;  // linha
+    std::size_t y = 0;  // coluna
+    bool livre = false;
+};
+
+//! Lê um roteiro de edições, uma "set(x,y,0|1)" por linha (espaços e
+//! linhas vazias são ignorados; '#' começa um comentário até o fim da
+//! linha). Retorna false, com 'linha_erro' preenchida, se alguma linha
+//! estiver fora desse formato.
+bool LeEdicoes(std::string_view texto, std::vector<Edicao>& edicoes,
+               std::size_t& linha_erro);
+
+//! CLASSE AREA INCREMENTAL
+//! Componentes conexas de um mapa mantidas ao longo de edições de uma
+//! célula, sem refazer o preenchimento do mapa inteiro:
+//! - liberar uma célula só pode unir componentes: a célula vira um
+//!   conjunto novo da união-busca, unido aos das vizinhas livres;
+//! - ocupar uma célula pode dividir a sua componente: se as vizinhas
+//!   livres continuam ligadas pelas outras células do anel 3x3 em volta,
+//!   nada muda além da área; senão, uma busca em largura intercalada
+//!   parte de cada grupo de vizinhas e para assim que todas se encontram,
+//!   ou que só um grupo segue aberto. Cada grupo que se esgota antes disso
+//!   é um pedaço separado e ganha um conjunto novo. Como as buscas andam
+//!   juntas, o custo é o do menor pedaço separado (ou o da distância até
+//!   os grupos se encontrarem), não o do mapa.
+class AreaIncremental {
+ public:
+    //! construtor padrao (mapa vazio)
+    AreaIncremental();
+    //! metodo copia o mapa e rotula as componentes (O(células)), com
+    //! vizinhança-4 ou 8 ('conectividade')
+    void inicia(const Grid& mapa, int conectividade = 4);
+    //! metodo aplica uma edição (fora do mapa ou sem mudança: ignorada)
+    void aplica(const Edicao& edicao);
+    //! metodo retorna a área alcançável a partir de (x, y) (0 se ocupada)
+    std::int64_t area(std::size_t x, std::size_t y);
+    //! metodo retorna o mapa atual
+    const Grid& mapa() const;
+
+ private:
+    template <typename Vizinhanca>
+    void libera(std::size_t x, std::size_t y);
+    template <typename Vizinhanca>
+    void ocupa(std::size_t x, std::size_t y);
+    template <typename Vizinhanca>
+    void separa(const std::uint32_t* sementes, int quantidade, std::uint32_t raiz);
+    //! une o conjunto da célula ao de 'raiz' e retorna a nova raiz
+    std::uint32_t junta(std::uint32_t raiz, std::size_t celula);
+
+    Grid mapa_;
+    std::vector<std::uint32_t> conjunto_;  // um por célula livre
+    std::vector<std::int64_t> areas_;  // área de cada conjunto (nas raízes)
+    UniaoBusca conjuntos_;
+    Componentes componentes_;  // rotulação inicial
+
+    // Buscas intercaladas (ocupa): a época da última visita e a busca que
+    // visitou, por célula; as células visitadas e o grupo de cada busca
+    std::vector<std::uint32_t> visita_;
+    std::vector<std::uint8_t> busca_;
+    std::vector<std::uint32_t> visitadas_[8];
+    std::uint32_t epoca_;
+    int conectividade_;
+};
+
+// lê um número sem sinal, pulando espaços antes dele
+inline const char* LeNumeroEdicao(const char* p, const char* fim, std::size_t& valor) {
+    while (p < fim && (*p == ' ' || *p == '\t')) p++;
+    auto resultado = std::from_chars(p, fim, valor);
+    return resultado.ec == std::errc() ? resultado.ptr : nullptr;
+}
+
+// pula espaços e confere o caractere esperado
+inline const char* LeSimboloEdicao(const char* p, const char* fim, char simbolo) {
+    while (p < fim && (*p == ' ' || *p == '\t')) p++;
+    return p < fim && *p == simbolo ? p + 1 : nullptr;
+}
+
+// lê o roteiro de edições
+inline bool LeEdicoes(std::string_view texto, std::vector<Edicao>& edicoes,
+                      std::size_t& linha_erro) {
+    edicoes.clear();
+    std::size_t numero = 0;
+    while (!texto.empty()) {
+        numero++;
+        std::size_t quebra = texto.find('\n');
+        std::string_view linha = texto.substr(0, quebra);
+        texto.remove_prefix(quebra == std::string_view::npos ? texto.size() : quebra + 1);
+        linha = linha.substr(0, linha.find('#'));
+
+        const char* p = linha.data();
+        const char* fim = p + linha.size();
+        while (p < fim && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p == fim) continue;
+
+        Edicao edicao;
+        std::size_t valor = 2;
+        p = std::string_view(p, fim - p).substr(0, 3) == "set" ? p + 3 : nullptr;
+        if (p) p = LeSimboloEdicao(p, fim, '(');
+        if (p) p = LeNumeroEdicao(p, fim, edicao.x);
+        if (p) p = LeSimboloEdicao(p, fim, ',');
+        if (p) p = LeNumeroEdicao(p, fim, edicao.y);
+        if (p) p = LeSimboloEdicao(p, fim, ',');
+        if (p) p = LeNumeroEdicao(p, fim, valor);
+        if (p) p = LeSimboloEdicao(p, fim, ')');
+        while (p && p < fim && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p != fim || valor > 1) {
+            linha_erro = numero;
+            return false;
+        }
+        edicao.livre = valor == 1;
+        edicoes.push_back(edicao);
+    }
+    return true;
+}
+
+// construtor padrao
+inline AreaIncremental::AreaIncremental() {
+    epoca_ = 0;
+    conectividade_ = 4;
+}
+
+// Cópia do mapa (que pode ser só uma visão de um .cenb) e rotulação
+// inicial: cada componente vira um conjunto, com o rótulo como índice
+inline void AreaIncremental::inicia(const Grid& mapa, int conectividade) {
+    std::size_t altura = mapa.altura(), largura = mapa.largura();
+    conectividade_ = conectividade;
+    mapa_.redimensiona(altura, largura);
+    for (std::size_t i = 0; i < altura; i++) {
+        for (std::size_t k = 0; k < mapa.palavras_por_linha(); k++) {
+            mapa_.linha(i)[k] = mapa.linha(i)[k];
+        }
+    }
+
+    componentes_.rotula(mapa_, conectividade);
+    conjuntos_.clear();
+    areas_.clear();
+    for (std::size_t r = 0; r <= componentes_.quantidade(); r++) {
+        conjuntos_.cria();
+        areas_.push_back(componentes_.area_rotulo(static_cast<std::uint32_t>(r)));
+    }
+    conjunto_.resize(altura * largura);
+    for (std::size_t i = 0; i < altura; i++) {
+        for (std::size_t j = 0; j < largura; j++) {
+            conjunto_[i * largura + j] = componentes_.rotulo(static_cast<int>(i),
+                                                             static_cast<int>(j));
+        }
+    }
+    visita_.assign(altura * largura, 0);
+    busca_.assign(altura * largura, 0);
+    epoca_ = 0;
+}
+
+// aplica uma edição
+inline void AreaIncremental::aplica(const Edicao& edicao) {
+    if (edicao.x >= mapa_.altura() || edicao.y >= mapa_.largura()) return;
+    if (mapa_.get(edicao.x, edicao.y) == edicao.livre) return;
+    if (edicao.livre) {
+        if (conectividade_ == 8) {
+            libera<Vizinhanca8>(edicao.x, edicao.y);
+        } else {
+            libera<Vizinhanca4>(edicao.x, edicao.y);
+        }
+    } else {
+        if (conectividade_ == 8) {
+            ocupa<Vizinhanca8>(edicao.x, edicao.y);
+        } else {
+            ocupa<Vizinhanca4>(edicao.x, edicao.y);
+        }
+    }
+}
+
+// área a partir de (x, y)
+inline std::int64_t AreaIncremental::area(std::size_t x, std::size_t y) {
+    if (x >= mapa_.altura() || y >= mapa_.largura() || !mapa_.get(x, y)) return 0;
+    return areas_[conjuntos_.busca(conjunto_[x * mapa_.largura() + y])];
+}
+
+// mapa atual
+inline const Grid& AreaIncremental::mapa() const {
+    return mapa_;
+}
+
+// une o conjunto da célula ao de 'raiz', somando as áreas
+inline std::uint32_t AreaIncremental::junta(std::uint32_t raiz, std::size_t celula) {
+    std::uint32_t outra = conjuntos_.busca(conjunto_[celula]);
+    if (outra == raiz) return raiz;
+    std::int64_t soma = areas_[raiz] + areas_[outra];
+    raiz = conjuntos_.une(raiz, outra);
+    areas_[raiz] = soma;
+    return raiz;
+}
+
+// Liberar: a célula entra como um conjunto de área 1, unido às vizinhas
+template <typename Vizinhanca>
+void AreaIncremental::libera(std::size_t x, std::size_t y) {
+    const std::size_t altura = mapa_.altura(), largura = mapa_.largura();
+    mapa_.set(x, y);
+    std::uint32_t raiz = conjuntos_.cria();
+    areas_.push_back(1);
+    conjunto_[x * largura + y] = raiz;
+    ParaCadaVizinho<Vizinhanca>([&](int dx, int dy) {
+        std::size_t i = x + dx, j = y + dy;  // fora do mapa: dá a volta
+        if (i < altura && j < largura && mapa_.get(i, j)) {
+            raiz = junta(raiz, i * largura + j);
+        }
+    });
+}
+
+// Ocupar: a área da componente cai em 1; as vizinhas livres só precisam
+// de busca se não estiverem todas ligadas pelo anel 3x3 em volta da célula
+template <typename Vizinhanca>
+void AreaIncremental::ocupa(std::size_t x, std::size_t y) {
+    const std::size_t altura = mapa_.altura(), largura = mapa_.largura();
+    std::uint32_t raiz = conjuntos_.busca(conjunto_[x * largura + y]);
+    areas_[raiz]--;
+    mapa_.reset(x, y);
+
+    // Anel em volta da célula, em sentido horário a partir do canto de cima
+    static constexpr int anel_dx[8] = {-1, -1, -1, 0, 1, 1, 1, 0};
+    static constexpr int anel_dy[8] = {-1, 0, 1, 1, 1, 0, -1, -1};
+    bool livre[8];
+    for (int a = 0; a < 8; a++) {
+        std::size_t i = x + anel_dx[a], j = y + anel_dy[a];
+        livre[a] = i < altura && j < largura && mapa_.get(i, j);
+    }
+    // Grupos de células livres do anel ligadas entre si sem passar pelo
+    // centro: vizinhas no anel, e na vizinhança-4 só as de lado (um canto
+    // liga as duas células de lado ao lado dele)
+    int grupo[8];
+    for (int a = 0; a < 8; a++) grupo[a] = a;
+    for (int a = 0; a < 8; a++) {
+        int b = (a + 1) % 8;
+        if (!livre[a] || !livre[b]) continue;
+        int de = grupo[b], para = grupo[a];
+        for (int c = 0; c < 8; c++) if (grupo[c] == de) grupo[c] = para;
+    }
+    if constexpr (Vizinhanca::diagonais) {
+        // Duas células de lado vizinhas ficam ligadas mesmo com o canto
+        // entre elas ocupado
+        for (int a = 1; a < 8; a += 2) {
+            int b = (a + 2) % 8;
+            if (!livre[a] || !livre[b]) continue;
+            int de = grupo[b], para = grupo[a];
+            for (int c = 0; c < 8; c++) if (grupo[c] == de) grupo[c] = para;
+        }
+    }
+
+    // Uma semente por grupo que contém alguma vizinha da célula
+    std::uint32_t sementes[8];
+    int quantidade = 0;
+    bool usado[8] = {};
+    for (int a = 0; a < 8; a++) {
+        bool vizinha = Vizinhanca::diagonais || a % 2 == 1;
+        if (!livre[a] || !vizinha || usado[grupo[a]]) continue;
+        usado[grupo[a]] = true;
+        sementes[quantidade++] = static_cast<std::uint32_t>(
+            (x + anel_dx[a]) * largura + y + anel_dy[a]);
+    }
+    if (quantidade > 1) separa<Vizinhanca>(sementes, quantidade, raiz);
+}
+
+// Buscas em largura intercaladas, uma célula de cada busca por rodada, a
+// partir de cada semente. Quando uma busca encontra uma célula de outra,
+// os dois grupos se juntam; um grupo cujas buscas se esgotam sem encontrar
+// as outras é um pedaço separado da componente 'raiz'. Termina quando
+// resta um só grupo aberto, que fica com o conjunto 'raiz'.
+template <typename Vizinhanca>
+void AreaIncremental::separa(const std::uint32_t* sementes, int quantidade,
+                             std::uint32_t raiz) {
+    const std::size_t altura = mapa_.altura(), largura = mapa_.largura();
+    if (++epoca_ == 0) {
+        visita_.assign(visita_.size(), 0);
+        epoca_ = 1;
+    }
+    int grupo[8];
+    std::size_t cabeca[8];
+    bool aberto[8];
+    for (int b = 0; b < quantidade; b++) {
+        grupo[b] = b;
+        cabeca[b] = 0;
+        aberto[b] = true;
+        visitadas_[b].assign(1, sementes[b]);
+        visita_[sementes[b]] = epoca_;
+        busca_[sementes[b]] = static_cast<std::uint8_t>(b);
+    }
+    auto une_grupos = [&](int de, int para) {
+        for (int b = 0; b < quantidade; b++) if (grupo[b] == de) grupo[b] = para;
+    };
+    int abertos = quantidade;
+
+    while (abertos > 1) {
+        for (int b = 0; b < quantidade && abertos > 1; b++) {
+            if (!aberto[grupo[b]] || cabeca[b] == visitadas_[b].size()) continue;
+            std::uint32_t celula = visitadas_[b][cabeca[b]++];
+            std::size_t x = celula / largura, y = celula % largura;
+            ParaCadaVizinho<Vizinhanca>([&](int dx, int dy) {
+                std::size_t i = x + dx, j = y + dy;
+                if (i >= altura || j >= largura || !mapa_.get(i, j)) return;
+                std::uint32_t vizinha = static_cast<std::uint32_t>(i * largura + j);
+                if (visita_[vizinha] != epoca_) {
+                    visita_[vizinha] = epoca_;
+                    busca_[vizinha] = static_cast<std::uint8_t>(b);
+                    visitadas_[b].push_back(vizinha);
+                } else if (grupo[busca_[vizinha]] != grupo[b]) {
+                    une_grupos(grupo[busca_[vizinha]], grupo[b]);
+                    abertos--;
+                }
+            });
+        }
+
+        // Grupos esgotados: cada um é um pedaço separado
+        for (int g = 0; g < quantidade && abertos > 1; g++) {
+            if (!aberto[g] || grupo[g] != g) continue;
+            bool esgotado = true;
+            for (int b = 0; b < quantidade; b++) {
+                if (grupo[b] == g && cabeca[b] < visitadas_[b].size()) esgotado = false;
+            }
+            if (!esgotado) continue;
+            std::uint32_t novo = conjuntos_.cria();
+            std::int64_t area = 0;
+            for (int b = 0; b < quantidade; b++) {
+                if (grupo[b] != g) continue;
+                for (std::uint32_t celula : visitadas_[b]) conjunto_[celula] = novo;
+                area += static_cast<std::int64_t>(visitadas_[b].size());
+            }
+            areas_.push_back(area);
+            areas_[raiz] -= area;
+            aberto[g] = false;
+            abertos--;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef ARQUIVO_MAPEADO_H
+#define ARQUIVO_MAPEADO_H
+
+#include <fcntl.h>  // open
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+
+#include <cstddef>  // std::size_t
+#include <string>
+#include <string_view>
+
+//! CLASSE ARQUIVO MAPEADO
+//! Mapeia um arquivo inteiro em memória, somente leitura. O conteúdo é
+//! acessado por std::string_view, sem nenhuma cópia: as páginas só são
+//! lidas do disco quando tocadas pela primeira vez.
+class ArquivoMapeado {
+ public:
+    //! construtor: abre e mapeia o arquivo 'caminho'
+    explicit ArquivoMapeado(const std::string& caminho);
+    //! destrutor: desfaz o mapeamento
+    ~ArquivoMapeado();
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+    //! verifica se o arquivo foi aberto e mapeado (como ifstream::is_open)
+    bool is_open() const;
+    //! metodo retorna o conteudo do arquivo
+    std::string_view conteudo() const;
+
+ private:
+    const char* dados_;
+    std::size_t tamanho_;
+    bool aberto_;
+};
+
+// construtor
+inline ArquivoMapeado::ArquivoMapeado(const std::string& caminho) {
+    dados_ = nullptr;
+    tamanho_ = 0;
+    aberto_ = false;
+
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return;
+    }
+    tamanho_ = static_cast<std::size_t>(info.st_size);
+
+    // mmap não aceita tamanho 0: um arquivo vazio fica sem mapeamento
+    if (tamanho_ > 0) {
+        void* p = mmap(nullptr, tamanho_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            tamanho_ = 0;
+            return;
+        }
+        // o arquivo é percorrido do início ao fim: pede leitura antecipada
+        madvise(p, tamanho_, MADV_SEQUENTIAL);
+        dados_ = static_cast<const char*>(p);
+    }
+    close(fd);  // o mapeamento continua válido após fechar o descritor
+    aberto_ = true;
+}
+
+// destrutor
+inline ArquivoMapeado::~ArquivoMapeado() {
+    if (dados_ != nullptr) {
+        munmap(const_cast<char*>(dados_), tamanho_);
+    }
+}
+
+// verifica se está aberto
+inline bool ArquivoMapeado::is_open() const {
+    return aberto_;
+}
+
+// retorna o conteúdo
+inline std::string_view ArquivoMapeado::conteudo() const {
+    return std::string_view(dados_, tamanho_);
+}
+
+#endif
@@ -45,7 +45,6 @@ class ArrayQueue {
 
 }  // namespace structures
 
-#endif
 
 //! construtor padrao
 template<typename T>
@@ -136,3 +135,5 @@ template<typename T>
 bool structures::ArrayQueue<T>::full() {
     return (size() == max_size_);
 }
+
+#endif
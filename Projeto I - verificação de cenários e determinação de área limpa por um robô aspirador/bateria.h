@@ -0,0 +1,152 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef BATERIA_H
+#define BATERIA_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t, std::int64_t
+#include <vector>
+
+#include "grid.h"
+#include "preenchimento.h"  // MemoriaPreenchimento
+#include "vizinhanca.h"
+
+//! Preenche 'acumulado' com o histograma acumulado das distâncias a partir
+//! de (x0, y0): acumulado[d] é a quantidade de células alcançáveis em no
+//! máximo d movimentos (vizinhança-4 ou 8, 'conectividade'). O último
+//! valor é a área sem limite de bateria; vazio se a célula do robô estiver
+//! ocupada ou fora do mapa.
+void CalcularHistogramaDistancias(const Grid& mapa, int x0, int y0,
+                                  MemoriaPreenchimento& memoria,
+                                  std::vector<std::int64_t>& acumulado,
+                                  int conectividade = 4);
+
+//! Área alcançável com bateria para no máximo 'k' movimentos, lida do
+//! histograma acumulado
+std::int64_t AreaComBateria(const std::vector<std::int64_t>& acumulado, std::size_t k);
+
+// Estado de uma palavra de 64 colunas durante a expansão. Os quatro
+// campos ficam juntos (32 bytes) para que examinar uma palavra traga uma
+// só linha de cache, e não uma de cada Grid.
+enum CampoDistancia : int {
+    CAMPO_LIVRE = 0,
+    CAMPO_VISITADA = 1,
+    CAMPO_FRONTEIRA = 2,
+    CAMPO_PROXIMA = 3
+};
+
+// Expansão da fronteira nível a nível, 64 células por operação: cada
+// palavra da fronteira espalha os seus bits para ela mesma (colunas ao
+// lado), para as palavras de cima e de baixo e, pelos bits da ponta, para
+// as palavras ao lado. O que chega a uma palavra, restrito às células
+// livres ainda não visitadas, é a nova fronteira dela, e a quantidade de
+// bits novos é o número de células a exatamente d movimentos. Só as
+// palavras que podem ganhar alguma célula entram no nível seguinte (em
+// 'memoria.proxima', como pares linha, palavra), então o custo total
+// acompanha a passagem da frente pelo mapa, e não o número de níveis
+// vezes o tamanho do mapa.
+template <typename Vizinhanca>
+inline void HistogramaDistancias(const Grid& mapa, int x0, int y0,
+                                 MemoriaPreenchimento& memoria,
+                                 std::vector<std::int64_t>& acumulado) {
+    const std::size_t altura = mapa.altura();
+    const std::size_t n = mapa.palavras_por_linha();
+    std::vector<std::uint64_t>& estado = memoria.livres;
+    estado.assign(4 * altura * n, 0);
+    for (std::size_t i = 0; i < altura; i++) {
+        const std::uint64_t* linha = mapa.linha(i);
+        for (std::size_t k = 0; k < n; k++) {
+            estado[4 * (i * n + k) + CAMPO_LIVRE] = linha[k];
+        }
+    }
+    std::vector<std::uint32_t>& ativas = memoria.fila;
+    std::vector<std::uint32_t>& novas = memoria.proxima;
+    ativas.clear();
+    novas.clear();
+
+    std::uint64_t* palavra_robo = estado.data() + 4 * (x0 * n + y0 / 64);
+    palavra_robo[CAMPO_VISITADA] = std::uint64_t(1) << (y0 % 64);
+    palavra_robo[CAMPO_FRONTEIRA] = palavra_robo[CAMPO_VISITADA];
+    ativas.push_back(static_cast<std::uint32_t>(x0));
+    ativas.push_back(static_cast<std::uint32_t>(y0 / 64));
+    acumulado.assign(1, 1);
+
+    // Leva 'bits' para a palavra (i, k); ela entra em 'novas' na primeira
+    // vez, no nível, em que algum bit cai numa célula livre não visitada
+    // (a próxima fronteira de cada palavra volta a zero no fim do nível)
+    auto leva = [&](std::size_t i, std::size_t k, std::uint64_t bits) {
+        std::uint64_t* palavra = estado.data() + 4 * (i * n + k);
+        bits &= palavra[CAMPO_LIVRE] & ~palavra[CAMPO_VISITADA];
+        if (bits == 0) return;
+        if (palavra[CAMPO_PROXIMA] == 0) {
+            novas.push_back(static_cast<std::uint32_t>(i));
+            novas.push_back(static_cast<std::uint32_t>(k));
+        }
+        palavra[CAMPO_PROXIMA] |= bits;
+    };
+
+    while (!ativas.empty()) {
+        TELEMETRIA_CONTA(memoria.estatisticas.fila(ativas.size() / 2);)
+        for (std::size_t a = 0; a < ativas.size(); a += 2) {
+            std::size_t i = ativas[a], k = ativas[a + 1];
+            std::uint64_t f = estado[4 * (i * n + k) + CAMPO_FRONTEIRA];
+            std::uint64_t lados = f << 1 | f >> 1;
+            std::uint64_t vertical = Vizinhanca::diagonais ? f | lados : f;
+            leva(i, k, lados);
+            if (i > 0) leva(i - 1, k, vertical);
+            if (i + 1 < altura) leva(i + 1, k, vertical);
+            // Bits da ponta passam para as palavras ao lado (e, com
+            // diagonais, também para as de cima e de baixo delas)
+            std::size_t i0 = Vizinhanca::diagonais && i > 0 ? i - 1 : i;
+            std::size_t i1 = Vizinhanca::diagonais && i + 1 < altura ? i + 1 : i;
+            for (std::size_t vi = i0; vi <= i1; vi++) {
+                if (k > 0 && (f & 1u)) leva(vi, k - 1, std::uint64_t(1) << 63);
+                if (k + 1 < n && (f >> 63)) leva(vi, k + 1, 1u);
+            }
+        }
+
+        // A fronteira atual sai e a nova entra no lugar dela
+        for (std::size_t a = 0; a < ativas.size(); a += 2) {
+            estado[4 * (ativas[a] * n + ativas[a + 1]) + CAMPO_FRONTEIRA] = 0;
+        }
+        std::int64_t quantidade = 0;
+        for (std::size_t a = 0; a < novas.size(); a += 2) {
+            std::uint64_t* palavra = estado.data() + 4 * (novas[a] * n + novas[a + 1]);
+            palavra[CAMPO_VISITADA] |= palavra[CAMPO_PROXIMA];
+            palavra[CAMPO_FRONTEIRA] = palavra[CAMPO_PROXIMA];
+            quantidade += __builtin_popcountll(palavra[CAMPO_PROXIMA]);
+            palavra[CAMPO_PROXIMA] = 0;
+        }
+        ativas.swap(novas);
+        novas.clear();
+        if (quantidade > 0) acumulado.push_back(acumulado.back() + quantidade);
+    }
+    TELEMETRIA_CONTA(memoria.estatisticas.visitadas = acumulado.back();)
+    TELEMETRIA_CONTA(memoria.estatisticas.passadas = acumulado.size();)
+}
+
+// escolhe a vizinhança
+inline void CalcularHistogramaDistancias(const Grid& mapa, int x0, int y0,
+                                         MemoriaPreenchimento& memoria,
+                                         std::vector<std::int64_t>& acumulado,
+                                         int conectividade) {
+    TELEMETRIA_CONTA(memoria.estatisticas.zera();)
+    acumulado.clear();
+    if (x0 < 0 || y0 < 0 || static_cast<std::size_t>(x0) >= mapa.altura() ||
+        static_cast<std::size_t>(y0) >= mapa.largura() || !mapa.get(x0, y0)) {
+        return;
+    }
+    if (conectividade == 8) {
+        HistogramaDistancias<Vizinhanca8>(mapa, x0, y0, memoria, acumulado);
+    } else {
+        HistogramaDistancias<Vizinhanca4>(mapa, x0, y0, memoria, acumulado);
+    }
+}
+
+// área com bateria para k movimentos
+inline std::int64_t AreaComBateria(const std::vector<std::int64_t>& acumulado,
+                                   std::size_t k) {
+    if (acumulado.empty()) return 0;
+    return acumulado[k < acumulado.size() ? k : acumulado.size() - 1];
+}
+
+#endif
@@ -0,0 +1,189 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef CACHE_AREAS_H
+#define CACHE_AREAS_H
+
+#include <atomic>
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t, std::int64_t
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "grid.h"
+
+//! Chave de 128 bits de um cenário: espalhamento de (altura, largura,
+//! bits do mapa, x, y, conectividade)
+struct ChaveCenario {
+    std::uint64_t a;
+    std::uint64_t b;
+    bool operator==(const ChaveCenario& outra) const {
+        return a == outra.a && b == outra.b;
+    }
+};
+
+//! Calcula a chave do mapa com o robô em (x, y) e a vizinhança dada. Percorre as palavras do
+//! grid em duas trilhas independentes de multiplicação e rotação (no
+//! estilo do xxHash), que são misturadas no final; o custo é O(palavras),
+//! bem menor que o de qualquer preenchimento.
+ChaveCenario CalculaChave(const Grid& mapa, std::size_t x, std::size_t y,
+                          int conectividade = 4);
+
+//! CLASSE CACHE DE AREAS
+//! Cache persistente "endereçado por conteúdo": guarda a área calculada
+//! para cada chave, em um arquivo de registros de tamanho fixo
+//! (chave.a, chave.b, área). Os resultados novos são acrescentados ao fim
+//! do arquivo em grava(). Pode ser usado por várias threads ao mesmo tempo.
+class CacheAreas {
+ public:
+    //! construtor padrao (cache vazio, sem arquivo)
+    CacheAreas();
+    //! metodo lê os registros de 'caminho' (um arquivo ausente é um cache vazio)
+    void carrega(const std::string& caminho);
+    //! metodo procura a chave; conta um acerto ou uma falta
+    bool busca(const ChaveCenario& chave, std::int64_t& area);
+    //! metodo guarda uma área nova
+    void guarda(const ChaveCenario& chave, std::int64_t area);
+    //! metodo retorna quantas áreas novas ainda não foram gravadas
+    std::size_t pendentes();
+    //! metodo esquece as áreas novas guardadas depois das 'desde' primeiras
+    //! pendentes (as de um XML que se revelou mal aninhado)
+    void descarta(std::size_t desde);
+    //! metodo acrescenta ao arquivo as áreas novas; false em erro de escrita
+    bool grava();
+    //! metodo retorna a quantidade de acertos
+    std::size_t acertos() const;
+    //! metodo retorna a quantidade de faltas
+    std::size_t faltas() const;
+
+ private:
+    struct Espalha {
+        std::size_t operator()(const ChaveCenario& chave) const {
+            return static_cast<std::size_t>(chave.a);
+        }
+    };
+    struct Registro {
+        std::uint64_t a;
+        std::uint64_t b;
+        std::int64_t area;
+    };
+
+    std::string caminho_;
+    std::mutex trava_;
+    std::unordered_map<ChaveCenario, std::int64_t, Espalha> areas_;
+    std::vector<Registro> novos_;
+    std::atomic<std::size_t> acertos_;
+    std::atomic<std::size_t> faltas_;
+};
+
+inline std::uint64_t RotacionaEsquerda(std::uint64_t v, int k) {
+    return (v << k) | (v >> (64 - k));
+}
+
+// mistura final do MurmurHash3
+inline std::uint64_t MisturaFinal(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// chave do cenário
+inline ChaveCenario CalculaChave(const Grid& mapa, std::size_t x, std::size_t y,
+                                 int conectividade) {
+    const std::uint64_t P1 = 0x9e3779b185ebca87ull;
+    const std::uint64_t P2 = 0xc2b2ae3d27d4eb4full;
+    const std::uint64_t P3 = 0x165667b19e3779f9ull;
+
+    std::uint64_t a = P1 ^ mapa.altura();
+    std::uint64_t b = P2 ^ mapa.largura();
+    std::size_t n = mapa.altura() * mapa.palavras_por_linha();
+    const std::uint64_t* p = n > 0 ? mapa.linha(0) : nullptr;
+    for (std::size_t w = 0; w < n; w++) {
+        a = RotacionaEsquerda(a ^ (p[w] * P2), 31) * P1;
+        b = RotacionaEsquerda(b + p[w] * P3, 27) * P2;
+    }
+    a ^= RotacionaEsquerda(x * P3, 17);
+    b ^= RotacionaEsquerda(y * P1, 23);
+    if (conectividade != 4) a ^= P2 * static_cast<std::uint64_t>(conectividade);
+
+    ChaveCenario chave;
+    chave.a = MisturaFinal(a + b);
+    chave.b = MisturaFinal(b ^ RotacionaEsquerda(a, 29));
+    return chave;
+}
+
+// construtor padrao
+inline CacheAreas::CacheAreas() : acertos_(0), faltas_(0) {}
+
+// lê o arquivo
+inline void CacheAreas::carrega(const std::string& caminho) {
+    caminho_ = caminho;
+    std::ifstream arquivo(caminho, std::ios::binary);
+    Registro r;
+    while (arquivo.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+        areas_[ChaveCenario{r.a, r.b}] = r.area;
+    }
+}
+
+// procura
+inline bool CacheAreas::busca(const ChaveCenario& chave, std::int64_t& area) {
+    std::lock_guard<std::mutex> trava(trava_);
+    auto it = areas_.find(chave);
+    if (it == areas_.end()) {
+        faltas_++;
+        return false;
+    }
+    acertos_++;
+    area = it->second;
+    return true;
+}
+
+// guarda
+inline void CacheAreas::guarda(const ChaveCenario& chave, std::int64_t area) {
+    std::lock_guard<std::mutex> trava(trava_);
+    if (areas_.emplace(chave, area).second) {
+        novos_.push_back(Registro{chave.a, chave.b, area});
+    }
+}
+
+// áreas novas ainda não gravadas
+inline std::size_t CacheAreas::pendentes() {
+    std::lock_guard<std::mutex> trava(trava_);
+    return novos_.size();
+}
+
+// esquece as áreas novas a partir de 'desde'
+inline void CacheAreas::descarta(std::size_t desde) {
+    std::lock_guard<std::mutex> trava(trava_);
+    for (std::size_t k = desde; k < novos_.size(); k++) {
+        areas_.erase(ChaveCenario{novos_[k].a, novos_[k].b});
+    }
+    if (desde < novos_.size()) novos_.resize(desde);
+}
+
+// acrescenta as novas ao arquivo
+inline bool CacheAreas::grava() {
+    std::lock_guard<std::mutex> trava(trava_);
+    if (novos_.empty() || caminho_.empty()) return true;
+    std::ofstream arquivo(caminho_, std::ios::binary | std::ios::app);
+    arquivo.write(reinterpret_cast<const char*>(novos_.data()),
+                  novos_.size() * sizeof(Registro));
+    novos_.clear();
+    return static_cast<bool>(arquivo);
+}
+
+// acertos
+inline std::size_t CacheAreas::acertos() const {
+    return acertos_;
+}
+
+// faltas
+inline std::size_t CacheAreas::faltas() const {
+    return faltas_;
+}
+
+#endif
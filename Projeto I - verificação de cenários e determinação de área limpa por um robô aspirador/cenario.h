@@ -0,0 +1,109 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef CENARIO_H
+#define CENARIO_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <string_view>
+#include <utility>  // std::pair
+#include <vector>
+
+#include "tokenizador_xml.h"
+#include "vizinhanca.h"  // conectividade_de_valor
+
+//! ESTRUTURA CENARIO
+//! Os campos de texto do Cenario são visões (string_view) sobre o arquivo
+//! mapeado (ou sobre o buffer de LeitorFluxo): nenhum nome ou matriz é
+//! copiado, então o texto precisa continuar lá enquanto o Cenario for usado.
+//!
+//! Um cenário pode trazer um único <robo> ou uma lista <robos> com vários
+//! <robo>; no segundo caso as posições ficam em 'robos', na ordem do XML.
+//! O elemento opcional <conectividade> (4 ou 8) escolhe se o robô anda
+//! também nas diagonais; sem ele, a vizinhança é 4.
+struct Cenario {
+    std::string_view nome;
+    std::size_t altura = 0;
+    std::size_t largura = 0;
+    std::size_t x = 0;
+    std::size_t y = 0;
+    std::string_view matriz;  // conteúdo bruto de <matriz>, com quebras de linha
+    const std::uint64_t* bits = nullptr;  // mapa já em bits (arquivos .cenb)
+    bool lista_robos = false;  // o cenário usa <robos>
+    std::vector<std::pair<std::size_t, std::size_t>> robos;  // (x, y) de cada robô de <robos>
+    int conectividade = 4;  // 4 ou 8 vizinhos
+
+    // Volta ao estado inicial, mantendo a memória da lista de robôs
+    void limpa() {
+        nome = matriz = std::string_view();
+        bits = nullptr;
+        altura = largura = x = y = 0;
+        lista_robos = false;
+        robos.clear();
+        conectividade = 4;
+    }
+};
+
+//! Registra um evento do tokenizador no verificador e no cenário 'atual';
+//! a cada </cenario>, entrega 'atual' a 'ao_ler'. Retorna false se o
+//! aninhamento estiver errado. Usado por LerCenarios e pela leitura em
+//! blocos (leitor_fluxo.h), que assim tratam o XML da mesma forma.
+template <typename Funcao>
+bool ProcessaEventoCenario(const EventoXML& evento, VerificadorAninhamento& verificador,
+                           Cenario& atual, Funcao& ao_ler) {
+    int id;
+    if (!verificador.processa(evento, id)) return false;  // Erro de aninhamento
+
+    if (evento.tipo == TipoEvento::Fechamento) {
+        if (id == TAG_CENARIO) ao_ler(atual);
+        if (id == TAG_ROBO && atual.lista_robos) {
+            atual.robos.push_back({atual.x, atual.y});
+        }
+        return true;
+    }
+
+    switch (id) {
+        case TAG_CENARIO: atual.limpa(); break;
+        case TAG_ROBOS:   atual.lista_robos = true; break;
+        case TAG_NOME:    atual.nome = evento.valor; break;
+        case TAG_ALTURA:  le_inteiro(evento.valor, atual.altura); break;
+        case TAG_LARGURA: le_inteiro(evento.valor, atual.largura); break;
+        case TAG_X:       le_inteiro(evento.valor, atual.x); break;
+        case TAG_Y:       le_inteiro(evento.valor, atual.y); break;
+        case TAG_MATRIZ:  atual.matriz = evento.valor; break;
+        case TAG_CONECTIVIDADE: {
+            std::size_t valor = 4;
+            le_inteiro(evento.valor, valor);
+            atual.conectividade = conectividade_de_valor(valor);
+            break;
+        }
+        default: break;
+    }
+    return true;
+}
+
+//! Percorre o XML uma única vez: verifica o aninhamento das tags e, ao mesmo
+//! tempo, preenche os campos do cenário atual. A cada </cenario> o cenário é
+//! entregue a 'ao_ler'. Retorna false se o aninhamento estiver errado; nesse
+//! caso os cenários já entregues devem ser descartados por quem chamou.
+template <typename Funcao>
+bool LerCenarios(std::string_view texto, Funcao ao_ler) {
+    VerificadorAninhamento verificador;
+    TokenizadorXML tokens(texto);
+    EventoXML evento;
+    Cenario atual;
+
+    while (tokens.proximo(evento)) {
+        if (!ProcessaEventoCenario(evento, verificador, atual, ao_ler)) return false;
+    }
+    // Erro: tag não fechada ou com '<' dentro dela
+    if (evento.tipo == TipoEvento::Erro) return false;
+
+    return verificador.completo();  // Se a pilha estiver vazia, o XML está bem aninhado
+}
+
+//! Apenas a verificação de aninhamento, sem uso dos cenários
+inline bool verificarAninhamentoXML(std::string_view texto) {
+    return LerCenarios(texto, [](const Cenario&) {});
+}
+
+#endif
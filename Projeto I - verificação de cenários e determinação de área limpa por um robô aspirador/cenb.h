@@ -0,0 +1,193 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef CENB_H
+#define CENB_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t
+#include <cstring>  // std::memcpy
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "cenario.h"
+#include "grid.h"
+
+// Formato binário .cenb: os mesmos cenários do XML, com o mapa já no
+// formato de Grid, para ser usado direto do arquivo mapeado, sem leitura
+// de texto. Inteiros e palavras do mapa são copiados na ordem de bytes
+// do processador, que precisa ser little-endian (ver o static_assert
+// abaixo); tudo alinhado em 8 bytes.
+//
+//   cabeçalho:  "CENB" | versão (uint32) | quantidade de cenários (uint64)
+//   cada cenário:
+//     altura | largura                                  (uint64 cada)
+//     tamanho do nome | quantidade de robôs             (uint32 cada)
+//     lista de robôs (1 se veio de <robos>) | conectividade (uint32 cada;
+//     0, de arquivos mais antigos, vale 4)
+//     x | y de cada robô                                (uint64 cada)
+//     nome, completado com zeros até múltiplo de 8 bytes
+//     mapa: altura * ceil(largura / 64) palavras de 64 bits
+
+//! Verifica se 'dados' começa com a assinatura de um arquivo .cenb
+bool EhCenb(std::string_view dados);
+
+//! Lê um arquivo .cenb mapeado em memória e entrega cada cenário a
+//! 'ao_ler'. O campo 'bits' do Cenario aponta para o mapa dentro do
+//! próprio arquivo. Retorna false se o arquivo estiver truncado ou
+//! corrompido.
+template<typename Funcao>
+bool LerCenariosCenb(std::string_view dados, Funcao ao_ler);
+
+//! CLASSE ESCRITOR CENB
+//! Grava cenários no formato .cenb, um de cada vez; a quantidade do
+//! cabeçalho é preenchida ao fechar.
+class EscritorCenb {
+ public:
+    //! construtor: cria o arquivo 'caminho' e escreve o cabeçalho
+    explicit EscritorCenb(const std::string& caminho);
+    //! verifica se o arquivo foi criado
+    bool is_open() const;
+    //! metodo grava um cenário com o seu mapa
+    void adiciona(const Cenario& cenario, const Grid& mapa);
+    //! metodo atualiza o cabeçalho e fecha o arquivo; false em erro de escrita
+    bool fecha();
+
+ private:
+    void escreve32(std::uint32_t valor);
+    void escreve64(std::uint64_t valor);
+
+    std::ofstream arquivo_;
+    std::uint64_t quantidade_;
+};
+
+// O mapa é usado direto do arquivo mapeado, como palavras de 64 bits, então
+// trocar a ordem dos bytes custaria a cópia que o formato quer evitar
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "o formato .cenb pressupõe um processador little-endian");
+
+static const char CENB_ASSINATURA[4] = {'C', 'E', 'N', 'B'};
+static const std::uint32_t CENB_VERSAO = 1;
+
+// assinatura
+inline bool EhCenb(std::string_view dados) {
+    return dados.size() >= 16 && std::memcmp(dados.data(), CENB_ASSINATURA, 4) == 0;
+}
+
+// leitura
+template<typename Funcao>
+bool LerCenariosCenb(std::string_view dados, Funcao ao_ler) {
+    const char* base = dados.data();
+    std::size_t n = dados.size();
+    if (!EhCenb(dados)) return false;
+
+    std::uint32_t versao;
+    std::uint64_t quantidade;
+    std::memcpy(&versao, base + 4, 4);
+    std::memcpy(&quantidade, base + 8, 8);
+    if (versao != CENB_VERSAO) return false;
+
+    std::size_t pos = 16;
+    Cenario atual;
+    for (std::uint64_t k = 0; k < quantidade; k++) {
+        std::uint64_t altura, largura;
+        std::uint32_t tamanho_nome, robos, lista, conectividade;
+        if (n - pos < 32) return false;
+        std::memcpy(&altura, base + pos, 8);
+        std::memcpy(&largura, base + pos + 8, 8);
+        std::memcpy(&tamanho_nome, base + pos + 16, 4);
+        std::memcpy(&robos, base + pos + 20, 4);
+        std::memcpy(&lista, base + pos + 24, 4);
+        std::memcpy(&conectividade, base + pos + 28, 4);
+        pos += 32;
+
+        atual.limpa();
+        atual.altura = altura;
+        atual.largura = largura;
+        atual.lista_robos = lista != 0;
+        atual.conectividade = conectividade_de_valor(conectividade);
+        if ((n - pos) / 16 < robos) return false;
+        for (std::uint32_t r = 0; r < robos; r++) {
+            std::uint64_t x, y;
+            std::memcpy(&x, base + pos, 8);
+            std::memcpy(&y, base + pos + 8, 8);
+            pos += 16;
+            atual.x = x;
+            atual.y = y;
+            if (atual.lista_robos) atual.robos.push_back({x, y});
+        }
+
+        std::size_t nome_alinhado = (static_cast<std::size_t>(tamanho_nome) + 7) & ~std::size_t(7);
+        if (n - pos < nome_alinhado) return false;
+        atual.nome = std::string_view(base + pos, tamanho_nome);
+        pos += nome_alinhado;
+
+        std::uint64_t palavras = (largura + 63) / 64;
+        if (palavras != 0 && altura > (n - pos) / 8 / palavras) return false;
+        atual.bits = reinterpret_cast<const std::uint64_t*>(base + pos);
+        pos += altura * palavras * 8;
+
+        ao_ler(atual);
+    }
+    return true;
+}
+
+// construtor
+inline EscritorCenb::EscritorCenb(const std::string& caminho)
+    : arquivo_(caminho, std::ios::binary | std::ios::trunc) {
+    quantidade_ = 0;
+    arquivo_.write(CENB_ASSINATURA, 4);
+    escreve32(CENB_VERSAO);
+    escreve64(0);  // quantidade, preenchida em fecha()
+}
+
+// arquivo aberto
+inline bool EscritorCenb::is_open() const {
+    return arquivo_.is_open();
+}
+
+// grava um cenário
+inline void EscritorCenb::adiciona(const Cenario& cenario, const Grid& mapa) {
+    static const char zeros[8] = {0};
+    escreve64(mapa.altura());
+    escreve64(mapa.largura());
+    escreve32(static_cast<std::uint32_t>(cenario.nome.size()));
+    if (cenario.lista_robos) {
+        escreve32(static_cast<std::uint32_t>(cenario.robos.size()));
+        escreve32(1);
+        escreve32(static_cast<std::uint32_t>(cenario.conectividade));
+        for (const std::pair<std::size_t, std::size_t>& robo : cenario.robos) {
+            escreve64(robo.first);
+            escreve64(robo.second);
+        }
+    } else {
+        escreve32(1);
+        escreve32(0);
+        escreve32(static_cast<std::uint32_t>(cenario.conectividade));
+        escreve64(cenario.x);
+        escreve64(cenario.y);
+    }
+    arquivo_.write(cenario.nome.data(), cenario.nome.size());
+    arquivo_.write(zeros, (8 - cenario.nome.size() % 8) % 8);
+    if (mapa.altura() > 0) {
+        arquivo_.write(reinterpret_cast<const char*>(mapa.linha(0)), mapa.bytes());
+    }
+    quantidade_++;
+}
+
+// fecha
+inline bool EscritorCenb::fecha() {
+    arquivo_.seekp(8);
+    escreve64(quantidade_);
+    arquivo_.close();
+    return !arquivo_.fail();
+}
+
+inline void EscritorCenb::escreve32(std::uint32_t valor) {
+    arquivo_.write(reinterpret_cast<const char*>(&valor), 4);
+}
+
+inline void EscritorCenb::escreve64(std::uint64_t valor) {
+    arquivo_.write(reinterpret_cast<const char*>(&valor), 8);
+}
+
+#endif
@@ -0,0 +1,202 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef DILATACAO_BITS_H
+#define DILATACAO_BITS_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DILATACAO_COM_AVX2 1
+#endif
+
+// Núcleos da dilatação de bits usada por AreaBits (preenchimento.h).
+//
+// Uma linha R do conjunto alcançado é atualizada como
+//     R = fecho_horizontal((R | cima | baixo) & livre)
+// onde o fecho horizontal completa cada trecho de células livres que já
+// tem alguma célula alcançada. Dentro de cada palavra de 64 bits o fecho é
+// feito com o preenchimento "oclusivo" de Kogge-Stone (6 deslocamentos em
+// cada sentido); a passagem de uma palavra para a vizinha é feita depois,
+// em ordem, por PropagaEntrePalavras.
+
+//! Assinatura dos núcleos de atualização de linha: retorna true se R mudou
+typedef bool (*NucleoDilatacao)(std::uint64_t* R, const std::uint64_t* cima,
+                                const std::uint64_t* baixo,
+                                const std::uint64_t* livre, std::size_t n);
+
+//! Espalha 'g' para as colunas maiores (bits mais altos) dentro de 'p'
+inline std::uint64_t EspalhaDireita(std::uint64_t g, std::uint64_t p) {
+    g |= p & (g << 1);  p &= p << 1;
+    g |= p & (g << 2);  p &= p << 2;
+    g |= p & (g << 4);  p &= p << 4;
+    g |= p & (g << 8);  p &= p << 8;
+    g |= p & (g << 16); p &= p << 16;
+    g |= p & (g << 32);
+    return g;
+}
+
+//! Espalha 'g' para as colunas menores (bits mais baixos) dentro de 'p'
+inline std::uint64_t EspalhaEsquerda(std::uint64_t g, std::uint64_t p) {
+    g |= p & (g >> 1);  p &= p >> 1;
+    g |= p & (g >> 2);  p &= p >> 2;
+    g |= p & (g >> 4);  p &= p >> 4;
+    g |= p & (g >> 8);  p &= p >> 8;
+    g |= p & (g >> 16); p &= p >> 16;
+    g |= p & (g >> 32);
+    return g;
+}
+
+//! Continua os trechos que atravessam a divisa entre palavras vizinhas
+inline bool PropagaEntrePalavras(std::uint64_t* R, const std::uint64_t* livre,
+                                 std::size_t n) {
+    bool mudou = false;
+    // Da palavra w-1 para w: trecho livre que começa no bit 0
+    for (std::size_t w = 1; w < n; w++) {
+        if ((R[w - 1] >> 63) && (livre[w] & 1u) && !(R[w] & 1u)) {
+            R[w] |= (~livre[w] & (livre[w] + 1)) - 1;
+            mudou = true;
+        }
+    }
+    // Da palavra w+1 para w: trecho livre que termina no bit 63
+    for (std::size_t w = n; w-- > 1; ) {
+        std::size_t v = w - 1;
+        if ((R[w] & 1u) && (livre[v] >> 63) && !(R[v] >> 63)) {
+            std::uint64_t ocupadas = ~livre[v];
+            if (ocupadas == 0) {
+                R[v] = ~std::uint64_t(0);
+            } else {
+                int h = 63 - __builtin_clzll(ocupadas);
+                R[v] |= ~std::uint64_t(0) << (h + 1);
+            }
+            mudou = true;
+        }
+    }
+    return mudou;
+}
+
+//! Núcleo escalar: uma palavra por vez
+inline bool AtualizaLinhaEscalar(std::uint64_t* R, const std::uint64_t* cima,
+                                 const std::uint64_t* baixo,
+                                 const std::uint64_t* livre, std::size_t n) {
+    std::uint64_t diferenca = 0;
+    for (std::size_t w = 0; w < n; w++) {
+        std::uint64_t g = (R[w] | cima[w] | baixo[w]) & livre[w];
+        g = EspalhaDireita(g, livre[w]) | EspalhaEsquerda(g, livre[w]);
+        diferenca |= g ^ R[w];
+        R[w] = g;
+    }
+    bool mudou = PropagaEntrePalavras(R, livre, n);
+    return diferenca != 0 || mudou;
+}
+
+//! Conta os bits em 1 (escalar)
+inline std::size_t ContaBitsEscalar(const std::uint64_t* p, std::size_t n) {
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < n; w++) total += __builtin_popcountll(p[w]);
+    return total;
+}
+
+#ifdef DILATACAO_COM_AVX2
+
+// Deslocamentos de 64 bits em cada uma das 4 palavras do registrador
+#define DILATACAO_PASSO_DIREITA(k)                                   \
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_slli_epi64(g, k))); \
+    p = _mm256_and_si256(p, _mm256_slli_epi64(p, k));
+#define DILATACAO_PASSO_ESQUERDA(k)                                  \
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_srli_epi64(g, k))); \
+    p = _mm256_and_si256(p, _mm256_srli_epi64(p, k));
+
+//! Núcleo AVX2: quatro palavras (256 células) por iteração
+__attribute__((target("avx2")))
+inline bool AtualizaLinhaAVX2(std::uint64_t* R, const std::uint64_t* cima,
+                              const std::uint64_t* baixo,
+                              const std::uint64_t* livre, std::size_t n) {
+    __m256i diferenca = _mm256_setzero_si256();
+    std::size_t w = 0;
+    for ( ; w + 4 <= n; w += 4) {
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(R + w));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cima + w));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(baixo + w));
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(livre + w));
+        __m256i semente = _mm256_and_si256(
+            _mm256_or_si256(r, _mm256_or_si256(c, b)), f);
+
+        __m256i g = semente;
+        __m256i p = f;
+        DILATACAO_PASSO_DIREITA(1)
+        DILATACAO_PASSO_DIREITA(2)
+        DILATACAO_PASSO_DIREITA(4)
+        DILATACAO_PASSO_DIREITA(8)
+        DILATACAO_PASSO_DIREITA(16)
+        DILATACAO_PASSO_DIREITA(32)
+        __m256i direita = g;
+
+        g = semente;
+        p = f;
+        DILATACAO_PASSO_ESQUERDA(1)
+        DILATACAO_PASSO_ESQUERDA(2)
+        DILATACAO_PASSO_ESQUERDA(4)
+        DILATACAO_PASSO_ESQUERDA(8)
+        DILATACAO_PASSO_ESQUERDA(16)
+        DILATACAO_PASSO_ESQUERDA(32)
+
+        __m256i novo = _mm256_or_si256(direita, g);
+        diferenca = _mm256_or_si256(diferenca, _mm256_xor_si256(novo, r));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(R + w), novo);
+    }
+    bool mudou = !_mm256_testz_si256(diferenca, diferenca);
+
+    // Palavras que sobram no fim da linha
+    std::uint64_t resto = 0;
+    for ( ; w < n; w++) {
+        std::uint64_t g = (R[w] | cima[w] | baixo[w]) & livre[w];
+        g = EspalhaDireita(g, livre[w]) | EspalhaEsquerda(g, livre[w]);
+        resto |= g ^ R[w];
+        R[w] = g;
+    }
+    bool mudou_divisas = PropagaEntrePalavras(R, livre, n);
+    return mudou || resto != 0 || mudou_divisas;
+}
+
+#undef DILATACAO_PASSO_DIREITA
+#undef DILATACAO_PASSO_ESQUERDA
+
+//! Conta os bits em 1 com a instrução popcnt
+__attribute__((target("avx2,popcnt")))
+inline std::size_t ContaBitsAVX2(const std::uint64_t* p, std::size_t n) {
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < n; w++) total += __builtin_popcountll(p[w]);
+    return total;
+}
+
+#endif  // DILATACAO_COM_AVX2
+
+//! Verifica, uma única vez, se o processador tem AVX2
+inline bool TemAVX2() {
+#ifdef DILATACAO_COM_AVX2
+    static const bool tem = __builtin_cpu_supports("avx2") &&
+                            __builtin_cpu_supports("popcnt");
+    return tem;
+#else
+    return false;
+#endif
+}
+
+//! Escolhe o núcleo de atualização de linha em tempo de execução
+inline NucleoDilatacao EscolheNucleoDilatacao() {
+#ifdef DILATACAO_COM_AVX2
+    if (TemAVX2()) return AtualizaLinhaAVX2;
+#endif
+    return AtualizaLinhaEscalar;
+}
+
+//! Conta os bits em 1 com o núcleo disponível
+inline std::size_t ContaBits(const std::uint64_t* p, std::size_t n) {
+#ifdef DILATACAO_COM_AVX2
+    if (TemAVX2()) return ContaBitsAVX2(p, n);
+#endif
+    return ContaBitsEscalar(p, n);
+}
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+// Medição de desempenho da leitura do XML e dos motores de preenchimento
+// em mapas sintéticos (gerador.h), de 100x100 até 20000x20000.
+//
+//   g++ -std=c++17 -O2 -pthread ferramentas/benchmark.cpp -o benchmark
+//   ./benchmark --layout=salas --max=3000
+//
+// Opções:
+//   --tamanhos=N,N,...   lados dos mapas (padrão 100,300,1000,3000,10000,20000)
+//   --max=N              ignora os tamanhos maiores que N
+//   --layout=aleatorio|labirinto|salas   --densidade=D   --semente=N
+//   --motores=bfs,varredura,...          (padrão: todos)
+//   --threads=N          threads do motor ladrilhos
+//
+// Para cada tamanho, mede a leitura completa do XML (LerCenarios, com o
+// mapa carregado no Grid), só a verificação (verificarAninhamentoXML), a
+// codificação de <matriz> em trechos (GridRLE) e cada motor. Cada etapa é
+// repetida até somar pelo menos 0,2 s e o melhor tempo é o informado. O
+// pico de memória (ru_maxrss) é o do processo até o fim da etapa, então só
+// cresce de uma linha para a outra: os mapas maiores (e o motor rotulos,
+// com 4 bytes por célula) dominam. Em 20000x20000 o XML sozinho ocupa
+// ~400 MB.
+#include <sys/resource.h>  // getrusage
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>  // std::printf
+#include <cstdlib>  // std::strtod
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gerador.h"
+#include "../cenario.h"
+#include "../grid.h"
+#include "../grid_rle.h"
+#include "../preenchimento.h"
+
+using namespace std;
+
+// lê um número sem sinal (o texto todo)
+bool LeNumero(string_view texto, size_t& valor) {
+    const char* fim = texto.data() + texto.size();
+    return !texto.empty() && from_chars(texto.data(), fim, valor).ptr == fim;
+}
+
+// separa uma lista "a,b,c"
+vector<string_view> Separa(string_view lista) {
+    vector<string_view> partes;
+    while (!lista.empty()) {
+        size_t virgula = lista.find(',');
+        partes.push_back(lista.substr(0, virgula));
+        if (virgula == string_view::npos) break;
+        lista.remove_prefix(virgula + 1);
+    }
+    return partes;
+}
+
+// pico de memória do processo, em MB
+double PicoMemoriaMB() {
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss / 1024.0;  // ru_maxrss em KB no Linux
+}
+
+// Melhor tempo (em segundos) de 'etapa', repetida até somar 0,2 s
+template <typename Etapa>
+double Mede(Etapa etapa) {
+    double melhor = 1e30, total = 0;
+    for (int repeticao = 0; repeticao < 100 && total < 0.2; repeticao++) {
+        auto inicio = chrono::steady_clock::now();
+        etapa();
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        if (segundos < melhor) melhor = segundos;
+        total += segundos;
+    }
+    return melhor;
+}
+
+void Linha(size_t lado, string_view etapa, double segundos, double celulas, long resultado) {
+    printf("%6zu  %-12.*s %12.6f %14.3e %10.1f %12ld\n", lado,
+           static_cast<int>(etapa.size()), etapa.data(), segundos,
+           celulas / segundos, PicoMemoriaMB(), resultado);
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    vector<size_t> tamanhos = {100, 300, 1000, 3000, 10000, 20000};
+    size_t maximo = 20000, threads = thread::hardware_concurrency(), semente = 1;
+    vector<Motor> motores = {Motor::BFS, Motor::Varredura, Motor::Bits,
+                             Motor::Rotulos, Motor::Ladrilhos, Motor::Trechos,
+                             Motor::Blocos};
+    vector<string_view> nomes_motores = {"bfs", "varredura", "bits", "rotulos",
+                                         "ladrilhos", "trechos", "blocos"};
+    ParametrosGerador p;
+    for (int i = 1; i < argc; i++) {
+        string_view opcao = argv[i];
+        size_t igual = opcao.find('=');
+        string_view chave = opcao.substr(0, igual);
+        string_view valor = igual == string_view::npos ? "" : opcao.substr(igual + 1);
+        bool ok = true;
+        if (chave == "--tamanhos") {
+            tamanhos.clear();
+            for (string_view parte : Separa(valor)) {
+                size_t lado;
+                ok = ok && LeNumero(parte, lado);
+                tamanhos.push_back(lado);
+            }
+        } else if (chave == "--max") {
+            ok = LeNumero(valor, maximo);
+        } else if (chave == "--layout") {
+            ok = layout_de_nome(valor, p.layout);
+        } else if (chave == "--densidade") {
+            string texto(valor);
+            char* fim;
+            p.densidade = strtod(texto.c_str(), &fim);
+            ok = !texto.empty() && *fim == '\0';
+        } else if (chave == "--semente") {
+            ok = LeNumero(valor, semente);
+        } else if (chave == "--threads") {
+            ok = LeNumero(valor, threads);
+        } else if (chave == "--motores") {
+            motores.clear();
+            nomes_motores = Separa(valor);
+            for (string_view nome : nomes_motores) {
+                Motor motor;
+                ok = ok && motor_de_nome(nome, motor);
+                motores.push_back(motor);
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "Opcao invalida: %.*s\n", static_cast<int>(opcao.size()), opcao.data());
+            return 1;
+        }
+    }
+    if (threads == 0) threads = 1;
+    p.semente = semente;
+
+    printf("%6s  %-12s %12s %14s %10s %12s\n", "lado", "etapa", "segundos",
+           "celulas/s", "pico_MB", "resultado");
+    for (size_t lado : tamanhos) {
+        if (lado > maximo) continue;
+        p.altura = lado;
+        p.largura = lado;
+        string xml = "<cenarios>\n";
+        EscreveCenarioXML("benchmark", p, xml);
+        xml += "</cenarios>\n";
+        double celulas = static_cast<double>(lado) * lado;
+
+        // Leitura completa: tokenização, verificação e carga do mapa
+        Grid mapa;
+        Cenario cenario;
+        bool valido = true;
+        double t = Mede([&] {
+            valido = LerCenarios(xml, [&](const Cenario& c) {
+                mapa.carrega(c.matriz, c.altura, c.largura);
+                cenario = c;
+            });
+        });
+        Linha(lado, "leitura", t, celulas, valido);
+
+        t = Mede([&] { valido = verificarAninhamentoXML(xml); });
+        Linha(lado, "verificacao", t, celulas, valido);
+
+        // <matriz> direto para trechos (motor trechos, sem o Grid)
+        GridRLE rle;
+        t = Mede([&] { rle.carrega(cenario.matriz, cenario.altura, cenario.largura); });
+        Linha(lado, "leitura_rle", t, celulas, static_cast<long>(rle.trechos().size()));
+
+        MemoriaPreenchimento memoria;
+        for (size_t k = 0; k < motores.size(); k++) {
+            int64_t area = 0;
+            t = Mede([&] {
+                area = CalcularAreaLimpeza(mapa, static_cast<int>(cenario.x),
+                                           static_cast<int>(cenario.y), motores[k],
+                                           threads, memoria);
+            });
+            Linha(lado, nomes_motores[k], t, celulas, static_cast<long>(area));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+// Gerador de arquivos XML de cenários sintéticos.
+//
+//   g++ -std=c++17 -O2 ferramentas/gerador.cpp -o gerador
+//   ./gerador --tamanho=2000 --layout=salas --densidade=0.1 > grande.xml
+//
+// Opções:
+//   --altura=N --largura=N   dimensões do mapa (--tamanho=N: as duas)
+//   --densidade=D            fração de obstáculos (aleatorio) ou de móveis (salas)
+//   --layout=aleatorio|labirinto|salas
+//   --sala=N                 lado das salas do layout salas
+//   --robo=centro|canto|aleatoria
+//   --quantidade=N           cenários no arquivo (cada um com outra semente)
+//   --semente=N
+#include <charconv>
+#include <cstdlib>  // std::strtod
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "gerador.h"
+
+using namespace std;
+
+// lê um número sem sinal (o texto todo)
+bool LeNumero(string_view texto, size_t& valor) {
+    const char* fim = texto.data() + texto.size();
+    return !texto.empty() && from_chars(texto.data(), fim, valor).ptr == fim;
+}
+
+int main(int argc, char* argv[]) {
+    ParametrosGerador p;
+    size_t quantidade = 1, semente = 1;
+    for (int i = 1; i < argc; i++) {
+        string_view opcao = argv[i];
+        size_t igual = opcao.find('=');
+        string_view chave = opcao.substr(0, igual);
+        string_view valor = igual == string_view::npos ? "" : opcao.substr(igual + 1);
+        bool ok;
+        if (chave == "--altura") {
+            ok = LeNumero(valor, p.altura);
+        } else if (chave == "--largura") {
+            ok = LeNumero(valor, p.largura);
+        } else if (chave == "--tamanho") {
+            ok = LeNumero(valor, p.altura);
+            p.largura = p.altura;
+        } else if (chave == "--densidade") {
+            string texto(valor);
+            char* fim;
+            p.densidade = strtod(texto.c_str(), &fim);
+            ok = !texto.empty() && *fim == '\0' && p.densidade >= 0 && p.densidade <= 1;
+        } else if (chave == "--layout") {
+            ok = layout_de_nome(valor, p.layout);
+        } else if (chave == "--sala") {
+            ok = LeNumero(valor, p.tamanho_sala) && p.tamanho_sala > 0;
+        } else if (chave == "--robo") {
+            ok = posicao_de_nome(valor, p.robo);
+        } else if (chave == "--quantidade") {
+            ok = LeNumero(valor, quantidade);
+        } else if (chave == "--semente") {
+            ok = LeNumero(valor, semente);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            cerr << "Opcao invalida: " << opcao << endl;
+            return 1;
+        }
+    }
+
+    string saida = "<cenarios>\n";
+    for (size_t k = 0; k < quantidade; k++) {
+        p.semente = semente + k;
+        EscreveCenarioXML("sintetico-" + to_string(k + 1), p, saida);
+        cout.write(saida.data(), saida.size());
+        saida.clear();
+    }
+    cout << "</cenarios>\n";
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Geração de cenários sintéticos para testes de desempenho (usada por
+// gerador.cpp e benchmark.cpp; o programa do VPL não inclui este arquivo).
+
+//! Disposição dos obstáculos
+enum class Layout {
+    Aleatorio,  // cada célula ocupada com probabilidade 'densidade'
+    Labirinto,  // corredores de 1 célula (árvore binária), sem ciclos
+    Salas  // salas quadradas com uma porta em cada parede e móveis aleatórios
+};
+
+//! Posição inicial do robô (a célula escolhida sempre fica livre)
+enum class PosicaoRobo {
+    Centro,
+    Canto,  // primeira célula livre, em ordem de linhas
+    Aleatoria
+};
+
+//! Parâmetros de um cenário gerado
+struct ParametrosGerador {
+    std::size_t altura = 100;
+    std::size_t largura = 100;
+    double densidade = 0.3;  // obstáculos (Aleatorio) ou móveis (Salas)
+    std::size_t tamanho_sala = 16;
+    Layout layout = Layout::Aleatorio;
+    PosicaoRobo robo = PosicaoRobo::Centro;
+    std::uint64_t semente = 1;
+};
+
+//! Converte os nomes usados na linha de comando; false se desconhecido
+bool layout_de_nome(std::string_view nome, Layout& layout);
+bool posicao_de_nome(std::string_view nome, PosicaoRobo& posicao);
+
+//! Gera a matriz ('1' livre, '0' ocupada), linha a linha, em 'celulas'
+//! (altura * largura caracteres) e a posição (x, y) do robô
+void GeraMatriz(const ParametrosGerador& p, std::vector<char>& celulas,
+                std::size_t& x, std::size_t& y);
+
+//! Anexa a 'saida' um <cenario> completo com o nome dado
+void EscreveCenarioXML(std::string_view nome, const ParametrosGerador& p,
+                       std::string& saida);
+
+//! Gerador pseudoaleatório SplitMix64 (rápido; bastante para mapas de teste)
+class Aleatorio {
+ public:
+    explicit Aleatorio(std::uint64_t semente) : estado_(semente) {}
+    std::uint64_t proximo() {
+        std::uint64_t z = (estado_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    //! verdadeiro com probabilidade 'p'
+    bool chance(double p) {
+        return (proximo() >> 11) * (1.0 / 9007199254740992.0) < p;
+    }
+    //! inteiro em [0, n)
+    std::size_t ate(std::size_t n) {
+        return n == 0 ? 0 : static_cast<std::size_t>(proximo() % n);
+    }
+
+ private:
+    std::uint64_t estado_;
+};
+
+// nome do layout
+inline bool layout_de_nome(std::string_view nome, Layout& layout) {
+    if (nome == "aleatorio") {
+        layout = Layout::Aleatorio;
+    } else if (nome == "labirinto") {
+        layout = Layout::Labirinto;
+    } else if (nome == "salas") {
+        layout = Layout::Salas;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// nome da posição
+inline bool posicao_de_nome(std::string_view nome, PosicaoRobo& posicao) {
+    if (nome == "centro") {
+        posicao = PosicaoRobo::Centro;
+    } else if (nome == "canto") {
+        posicao = PosicaoRobo::Canto;
+    } else if (nome == "aleatoria") {
+        posicao = PosicaoRobo::Aleatoria;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Labirinto pelo algoritmo da árvore binária: as células de linha e coluna
+// pares são salas de 1x1 e cada uma abre a passagem para cima ou para a
+// esquerda. Não precisa de pilha, então serve para mapas enormes.
+inline void GeraLabirinto(const ParametrosGerador& p, Aleatorio& aleatorio,
+                          std::vector<char>& celulas) {
+    std::size_t h = p.altura, w = p.largura;
+    celulas.assign(h * w, '0');
+    for (std::size_t i = 0; i < h; i += 2) {
+        for (std::size_t j = 0; j < w; j += 2) {
+            celulas[i * w + j] = '1';
+            bool cima = i > 0 && (j == 0 || aleatorio.chance(0.5));
+            if (cima) {
+                celulas[(i - 1) * w + j] = '1';
+            } else if (j > 0) {
+                celulas[i * w + j - 1] = '1';
+            }
+        }
+    }
+}
+
+// Salas de 'tamanho_sala' células separadas por paredes de 1 célula, com
+// uma porta em posição aleatória em cada parede e móveis espalhados
+inline void GeraSalas(const ParametrosGerador& p, Aleatorio& aleatorio,
+                      std::vector<char>& celulas) {
+    std::size_t h = p.altura, w = p.largura;
+    std::size_t passo = (p.tamanho_sala > 0 ? p.tamanho_sala : 1) + 1;
+    celulas.resize(h * w);
+    for (std::size_t i = 0; i < h; i++) {
+        for (std::size_t j = 0; j < w; j++) {
+            bool parede = i % passo == passo - 1 || j % passo == passo - 1;
+            bool livre = !parede && !aleatorio.chance(p.densidade);
+            celulas[i * w + j] = livre ? '1' : '0';
+        }
+    }
+    // Portas: uma na parede de baixo e uma na parede da direita de cada sala
+    for (std::size_t i0 = 0; i0 < h; i0 += passo) {
+        for (std::size_t j0 = 0; j0 < w; j0 += passo) {
+            std::size_t parede_i = i0 + passo - 1, parede_j = j0 + passo - 1;
+            if (parede_i < h) {
+                std::size_t j = j0 + aleatorio.ate(passo - 1);
+                if (j < w) celulas[parede_i * w + j] = '1';
+            }
+            if (parede_j < w) {
+                std::size_t i = i0 + aleatorio.ate(passo - 1);
+                if (i < h) celulas[i * w + parede_j] = '1';
+            }
+        }
+    }
+}
+
+// gera a matriz e a posição do robô
+inline void GeraMatriz(const ParametrosGerador& p, std::vector<char>& celulas,
+                       std::size_t& x, std::size_t& y) {
+    Aleatorio aleatorio(p.semente);
+    std::size_t h = p.altura, w = p.largura;
+    switch (p.layout) {
+        case Layout::Labirinto: GeraLabirinto(p, aleatorio, celulas); break;
+        case Layout::Salas: GeraSalas(p, aleatorio, celulas); break;
+        case Layout::Aleatorio:
+        default:
+            celulas.resize(h * w);
+            for (char& c : celulas) c = aleatorio.chance(p.densidade) ? '0' : '1';
+    }
+
+    x = 0;
+    y = 0;
+    if (h == 0 || w == 0) return;
+    switch (p.robo) {
+        case PosicaoRobo::Canto: {
+            std::size_t k = 0;
+            while (k + 1 < h * w && celulas[k] != '1') k++;
+            x = k / w;
+            y = k % w;
+            break;
+        }
+        case PosicaoRobo::Aleatoria:
+            x = aleatorio.ate(h);
+            y = aleatorio.ate(w);
+            break;
+        case PosicaoRobo::Centro:
+        default:
+            // No labirinto, as salas ficam nas linhas e colunas pares
+            x = p.layout == Layout::Labirinto ? (h / 2) & ~std::size_t(1) : h / 2;
+            y = p.layout == Layout::Labirinto ? (w / 2) & ~std::size_t(1) : w / 2;
+    }
+    celulas[x * w + y] = '1';
+}
+
+// escreve o <cenario>
+inline void EscreveCenarioXML(std::string_view nome, const ParametrosGerador& p,
+                              std::string& saida) {
+    std::vector<char> celulas;
+    std::size_t x, y;
+    GeraMatriz(p, celulas, x, y);
+
+    saida += "<cenario>\n<nome>";
+    saida.append(nome);
+    saida += "</nome>\n<dimensoes><altura>" + std::to_string(p.altura) +
+             "</altura><largura>" + std::to_string(p.largura) +
+             "</largura></dimensoes>\n<robo><x>" + std::to_string(x) +
+             "</x><y>" + std::to_string(y) + "</y></robo>\n<matriz>\n";
+    saida.reserve(saida.size() + p.altura * (p.largura + 1) + 32);
+    for (std::size_t i = 0; i < p.altura; i++) {
+        saida.append(celulas.data() + i * p.largura, p.largura);
+        saida += '\n';
+    }
+    saida += "</matriz>\n</cenario>\n";
+}
+
+#endif
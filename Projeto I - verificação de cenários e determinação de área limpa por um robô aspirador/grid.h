@@ -0,0 +1,196 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef GRID_H
+#define GRID_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <string_view>
+#include <vector>
+
+//! CLASSE GRID
+//! Matriz de ocupação com 1 bit por célula, em uma única alocação
+//! contígua. Cada linha ocupa um número inteiro de palavras de 64 bits
+//! (os bits que sobram no fim da linha ficam sempre em zero), e a coluna
+//! j de uma linha fica no bit (j % 64) da palavra (j / 64).
+//!
+//! O grid também pode ser só uma visão, somente leitura, de bits que já
+//! estão na memória nesse mesmo formato (ver aponta()).
+class Grid {
+ public:
+    //! construtor padrao (grid vazio)
+    Grid();
+    //! construtor com dimensoes (todas as células em zero)
+    Grid(std::size_t altura, std::size_t largura);
+    //! construtor de cópia (a cópia de uma visão continua sendo visão)
+    Grid(const Grid& outro);
+    Grid& operator=(const Grid& outro);
+    Grid(Grid&&) = default;
+    Grid& operator=(Grid&&) = default;
+    //! metodo redimensiona e zera, reaproveitando a memória já alocada
+    void redimensiona(std::size_t altura, std::size_t largura);
+    //! metodo preenche a partir do texto de <matriz> ('1' livre, '0' ocupado)
+    void carrega(std::string_view texto, std::size_t altura, std::size_t largura);
+    //! metodo passa a ler os bits de 'bits' (altura * palavras_por_linha
+    //! palavras), sem copiar; os métodos que escrevem não podem ser usados
+    void aponta(const std::uint64_t* bits, std::size_t altura, std::size_t largura);
+    //! metodo retorna o valor da célula
+    bool get(std::size_t linha, std::size_t coluna) const;
+    //! metodo marca a célula com 1
+    void set(std::size_t linha, std::size_t coluna);
+    //! metodo marca a célula com 0
+    void reset(std::size_t linha, std::size_t coluna);
+    //! metodo marca com 1 as colunas [inicio, fim) de uma linha
+    void set_intervalo(std::size_t linha, std::size_t inicio, std::size_t fim);
+    //! metodo retorna o início de uma linha
+    const std::uint64_t* linha(std::size_t i) const;
+    std::uint64_t* linha(std::size_t i);
+    //! metodo retorna a altura
+    std::size_t altura() const;
+    //! metodo retorna a largura
+    std::size_t largura() const;
+    //! metodo retorna a quantidade de palavras de 64 bits por linha
+    std::size_t palavras_por_linha() const;
+    //! metodo retorna os bytes ocupados pelas células
+    std::size_t bytes() const;
+
+ private:
+    std::vector<std::uint64_t> bits_;
+    const std::uint64_t* dados_;  // bits_.data() ou os bits de aponta()
+    std::size_t altura_;
+    std::size_t largura_;
+    std::size_t palavras_;  // palavras de 64 bits por linha
+};
+
+// construtor padrao
+inline Grid::Grid() {
+    dados_ = nullptr;
+    altura_ = 0;
+    largura_ = 0;
+    palavras_ = 0;
+}
+
+// construtor com dimensoes
+inline Grid::Grid(std::size_t altura, std::size_t largura) {
+    redimensiona(altura, largura);
+}
+
+// construtor de cópia
+inline Grid::Grid(const Grid& outro) {
+    *this = outro;
+}
+
+// atribuição por cópia
+inline Grid& Grid::operator=(const Grid& outro) {
+    if (this == &outro) return *this;
+    bits_ = outro.bits_;
+    altura_ = outro.altura_;
+    largura_ = outro.largura_;
+    palavras_ = outro.palavras_;
+    bool visao = outro.dados_ != outro.bits_.data();
+    dados_ = visao ? outro.dados_ : bits_.data();
+    return *this;
+}
+
+// redimensiona e zera
+inline void Grid::redimensiona(std::size_t altura, std::size_t largura) {
+    altura_ = altura;
+    largura_ = largura;
+    palavras_ = (largura + 63) / 64;
+    bits_.assign(altura_ * palavras_, 0);
+    dados_ = bits_.data();
+}
+
+// visão de bits externos
+inline void Grid::aponta(const std::uint64_t* bits, std::size_t altura,
+                         std::size_t largura) {
+    altura_ = altura;
+    largura_ = largura;
+    palavras_ = (largura + 63) / 64;
+    dados_ = bits;
+}
+
+// preenche a partir do texto bruto de <matriz>
+// Espaços e quebras de linha entre os dígitos são ignorados; se faltarem
+// dígitos, as células restantes ficam ocupadas (0).
+inline void Grid::carrega(std::string_view texto, std::size_t altura,
+                          std::size_t largura) {
+    redimensiona(altura, largura);
+    const char* p = texto.data();
+    const char* fim = p + texto.size();
+
+    for (std::size_t i = 0; i < altura_ && p < fim; i++) {
+        std::uint64_t* destino = linha(i);
+        for (std::size_t j = 0; j < largura_; j += 64) {
+            std::size_t n = largura_ - j < 64 ? largura_ - j : 64;
+            std::uint64_t palavra = 0;
+            for (std::size_t b = 0; b < n; b++) {
+                while (p < fim && *p != '0' && *p != '1') p++;
+                if (p == fim) break;
+                palavra |= static_cast<std::uint64_t>(*p - '0') << b;
+                p++;
+            }
+            destino[j / 64] = palavra;
+        }
+    }
+}
+
+// valor da célula
+inline bool Grid::get(std::size_t linha, std::size_t coluna) const {
+    return (dados_[linha * palavras_ + coluna / 64] >> (coluna % 64)) & 1u;
+}
+
+// marca com 1
+inline void Grid::set(std::size_t linha, std::size_t coluna) {
+    bits_[linha * palavras_ + coluna / 64] |= std::uint64_t(1) << (coluna % 64);
+}
+
+// marca com 0
+inline void Grid::reset(std::size_t linha, std::size_t coluna) {
+    bits_[linha * palavras_ + coluna / 64] &= ~(std::uint64_t(1) << (coluna % 64));
+}
+
+// marca um intervalo de colunas, uma palavra por vez
+inline void Grid::set_intervalo(std::size_t linha, std::size_t inicio,
+                                std::size_t fim) {
+    std::uint64_t* p = bits_.data() + linha * palavras_;
+    while (inicio < fim) {
+        std::size_t w = inicio / 64;
+        std::size_t ate = (w + 1) * 64 < fim ? (w + 1) * 64 : fim;
+        std::size_t n = ate - inicio;
+        std::uint64_t mascara = n == 64 ? ~std::uint64_t(0)
+                                        : ((std::uint64_t(1) << n) - 1);
+        p[w] |= mascara << (inicio % 64);
+        inicio = ate;
+    }
+}
+
+// início de uma linha
+inline const std::uint64_t* Grid::linha(std::size_t i) const {
+    return dados_ + i * palavras_;
+}
+
+inline std::uint64_t* Grid::linha(std::size_t i) {
+    return bits_.data() + i * palavras_;
+}
+
+// altura
+inline std::size_t Grid::altura() const {
+    return altura_;
+}
+
+// largura
+inline std::size_t Grid::largura() const {
+    return largura_;
+}
+
+// palavras por linha
+inline std::size_t Grid::palavras_por_linha() const {
+    return palavras_;
+}
+
+// bytes ocupados
+inline std::size_t Grid::bytes() const {
+    return altura_ * palavras_ * sizeof(std::uint64_t);
+}
+
+#endif
@@ -0,0 +1,167 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef GRID_RLE_H
+#define GRID_RLE_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t
+#include <string_view>
+#include <vector>
+
+#include "grid.h"
+
+//! Trecho [inicio, fim) de colunas livres consecutivas de uma linha
+struct TrechoLivre {
+    std::uint32_t inicio;
+    std::uint32_t fim;
+};
+
+//! CLASSE GRID RLE
+//! Mapa codificado por linha em trechos de células livres (run-length
+//! encoding). Todos os trechos ficam em um único vetor, em ordem de linha e
+//! de coluna, e cada linha guarda o índice do seu primeiro trecho. Em salas
+//! grandes e abertas, o número de trechos é muito menor que o de células.
+class GridRLE {
+ public:
+    //! construtor padrao (mapa vazio)
+    GridRLE();
+    //! metodo codifica direto do texto de <matriz> ('1' livre, '0' ocupado),
+    //! com as mesmas regras de Grid::carrega
+    void carrega(std::string_view texto, std::size_t altura, std::size_t largura);
+    //! metodo codifica um Grid, uma palavra de 64 colunas por vez
+    void de_grid(const Grid& mapa);
+    //! metodo retorna todos os trechos, em ordem de linha
+    const std::vector<TrechoLivre>& trechos() const;
+    //! metodo retorna o índice do primeiro trecho da linha i (os trechos da
+    //! linha são [primeiro(i), primeiro(i + 1)))
+    std::size_t primeiro(std::size_t i) const;
+    //! metodo retorna o índice do trecho que contém (i, j), ou -1 se a
+    //! célula estiver ocupada
+    std::ptrdiff_t procura(std::size_t i, std::size_t j) const;
+    //! metodo retorna a altura
+    std::size_t altura() const;
+    //! metodo retorna a largura
+    std::size_t largura() const;
+
+ private:
+    std::vector<TrechoLivre> trechos_;
+    std::vector<std::size_t> primeiro_;  // altura + 1 posições
+    std::size_t altura_;
+    std::size_t largura_;
+};
+
+// Primeira coluna >= c cujo bit vale 'valor' (ou um valor >= 64 * n)
+inline std::size_t ProximoBit(const std::uint64_t* linha, std::size_t n,
+                              std::size_t c, bool valor) {
+    std::size_t w = c / 64;
+    if (w >= n) return c;
+    std::uint64_t palavra = valor ? linha[w] : ~linha[w];
+    palavra &= ~std::uint64_t(0) << (c % 64);
+    while (palavra == 0) {
+        if (++w == n) return n * 64;
+        palavra = valor ? linha[w] : ~linha[w];
+    }
+    return w * 64 + __builtin_ctzll(palavra);
+}
+
+// construtor padrao
+inline GridRLE::GridRLE() {
+    primeiro_.assign(1, 0);
+    altura_ = 0;
+    largura_ = 0;
+}
+
+// codifica o texto de <matriz>
+// Espaços e quebras de linha entre os dígitos são ignorados; se faltarem
+// dígitos, as células restantes ficam ocupadas.
+inline void GridRLE::carrega(std::string_view texto, std::size_t altura,
+                             std::size_t largura) {
+    altura_ = altura;
+    largura_ = largura;
+    trechos_.clear();
+    primeiro_.resize(altura + 1);
+    const char* p = texto.data();
+    const char* fim = p + texto.size();
+
+    for (std::size_t i = 0; i < altura; i++) {
+        primeiro_[i] = trechos_.size();
+        std::size_t j = 0;
+        bool aberto = false;
+        std::uint32_t inicio = 0;
+        while (j < largura && p < fim) {
+            char c = *p++;
+            if (c != '0' && c != '1') continue;
+            if (c == '1' && !aberto) {
+                inicio = static_cast<std::uint32_t>(j);
+                aberto = true;
+            } else if (c == '0' && aberto) {
+                trechos_.push_back({inicio, static_cast<std::uint32_t>(j)});
+                aberto = false;
+            }
+            j++;
+        }
+        if (aberto) trechos_.push_back({inicio, static_cast<std::uint32_t>(j)});
+    }
+    primeiro_[altura] = trechos_.size();
+}
+
+// codifica um Grid
+inline void GridRLE::de_grid(const Grid& mapa) {
+    altura_ = mapa.altura();
+    largura_ = mapa.largura();
+    std::size_t n = mapa.palavras_por_linha();
+    trechos_.clear();
+    primeiro_.resize(altura_ + 1);
+    for (std::size_t i = 0; i < altura_; i++) {
+        primeiro_[i] = trechos_.size();
+        const std::uint64_t* linha = mapa.linha(i);
+        std::size_t j = ProximoBit(linha, n, 0, true);
+        while (j < largura_) {
+            std::size_t k = ProximoBit(linha, n, j, false);
+            if (k > largura_) k = largura_;
+            trechos_.push_back({static_cast<std::uint32_t>(j),
+                                static_cast<std::uint32_t>(k)});
+            j = ProximoBit(linha, n, k, true);
+        }
+    }
+    primeiro_[altura_] = trechos_.size();
+}
+
+// trechos
+inline const std::vector<TrechoLivre>& GridRLE::trechos() const {
+    return trechos_;
+}
+
+// primeiro trecho da linha
+inline std::size_t GridRLE::primeiro(std::size_t i) const {
+    return primeiro_[i];
+}
+
+// busca binária do trecho que contém a coluna j
+inline std::ptrdiff_t GridRLE::procura(std::size_t i, std::size_t j) const {
+    if (i >= altura_ || j >= largura_) return -1;
+    std::size_t baixo = primeiro_[i], alto = primeiro_[i + 1];
+    while (baixo < alto) {
+        std::size_t meio = (baixo + alto) / 2;
+        if (trechos_[meio].fim <= j) {
+            baixo = meio + 1;
+        } else {
+            alto = meio;
+        }
+    }
+    if (baixo < primeiro_[i + 1] && trechos_[baixo].inicio <= j) {
+        return static_cast<std::ptrdiff_t>(baixo);
+    }
+    return -1;
+}
+
+// altura
+inline std::size_t GridRLE::altura() const {
+    return altura_;
+}
+
+// largura
+inline std::size_t GridRLE::largura() const {
+    return largura_;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef INDICE_CENARIOS_H
+#define INDICE_CENARIOS_H
+
+#include <cstddef>  // std::size_t
+#include <cstring>  // std::memchr, std::memcmp
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "tokenizador_xml.h"
+
+//! Trecho [inicio, fim) do texto com um cenário, de '<cenario>' até o
+//! '>' de '</cenario>'
+struct TrechoCenario {
+    std::size_t inicio;
+    std::size_t fim;
+};
+
+//! Pré-varredura: encontra o trecho de cada cenário sem ler as outras
+//! tags. Retorna false se <cenario> e </cenario> não se alternarem (por
+//! exemplo, um cenário dentro de outro); nesse caso o índice não é usado.
+bool IndexaCenarios(std::string_view texto, std::vector<TrechoCenario>& trechos);
+
+//! Verifica o aninhamento das tags que ficam fora dos trechos indexados
+bool VerificaEsqueleto(std::string_view texto,
+                       const std::vector<TrechoCenario>& trechos);
+
+//! Retorna o conteúdo de <nome> de um trecho de cenário
+std::string_view NomeDoCenario(std::string_view trecho);
+
+// Próximo '<' seguido de 'c' ou '/' a partir de p (ou 'fim').
+// Com SSE2 compara 16 posições por vez: o byte e o seguinte são testados
+// juntos, então tags como <x>, <y> e <nome> quase nunca param a busca.
+inline const char* ProximoCandidato(const char* p, const char* fim) {
+#if defined(__SSE2__)
+    const __m128i menor = _mm_set1_epi8('<');
+    const __m128i letra_c = _mm_set1_epi8('c');
+    const __m128i barra = _mm_set1_epi8('/');
+    while (p + 17 <= fim) {
+        __m128i atual = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i seguinte = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        __m128i achou = _mm_and_si128(
+            _mm_cmpeq_epi8(atual, menor),
+            _mm_or_si128(_mm_cmpeq_epi8(seguinte, letra_c),
+                         _mm_cmpeq_epi8(seguinte, barra)));
+        int mascara = _mm_movemask_epi8(achou);
+        if (mascara != 0) return p + __builtin_ctz(mascara);
+        p += 16;
+    }
+#endif
+    while (p < fim) {
+        p = static_cast<const char*>(std::memchr(p, '<', fim - p));
+        if (p == nullptr) return fim;
+        if (p + 1 < fim && (p[1] == 'c' || p[1] == '/')) return p;
+        p++;
+    }
+    return fim;
+}
+
+// pré-varredura
+inline bool IndexaCenarios(std::string_view texto,
+                           std::vector<TrechoCenario>& trechos) {
+    static const char abre[] = "<cenario>";
+    static const char fecha[] = "</cenario>";
+    const std::size_t n_abre = sizeof(abre) - 1;
+    const std::size_t n_fecha = sizeof(fecha) - 1;
+
+    trechos.clear();
+    const char* base = texto.data();
+    const char* fim = base + texto.size();
+    const char* p = base;
+    bool dentro = false;
+    std::size_t inicio = 0;
+
+    while ((p = ProximoCandidato(p, fim)) < fim) {
+        std::size_t resta = fim - p;
+        if (resta >= n_abre && std::memcmp(p, abre, n_abre) == 0) {
+            if (dentro) return false;
+            dentro = true;
+            inicio = p - base;
+            p += n_abre;
+        } else if (resta >= n_fecha && std::memcmp(p, fecha, n_fecha) == 0) {
+            if (!dentro) return false;
+            dentro = false;
+            p += n_fecha;
+            trechos.push_back({inicio, static_cast<std::size_t>(p - base)});
+        } else {
+            p++;
+        }
+    }
+    return !dentro;
+}
+
+// aninhamento fora dos trechos
+// Cada trecho é um elemento <cenario> completo; sem eles, o que sobra
+// (como <cenarios> ... </cenarios>) precisa estar bem aninhado sozinho.
+inline bool VerificaEsqueleto(std::string_view texto,
+                              const std::vector<TrechoCenario>& trechos) {
+    VerificadorAninhamento verificador;
+    EventoXML evento;
+    int id;
+    std::size_t inicio = 0;
+    for (std::size_t k = 0; k <= trechos.size(); k++) {
+        std::size_t fim = k < trechos.size() ? trechos[k].inicio : texto.size();
+        TokenizadorXML tokens(texto.substr(0, fim), inicio);
+        while (tokens.proximo(evento)) {
+            if (!verificador.processa(evento, id)) return false;
+        }
+        if (evento.tipo == TipoEvento::Erro) return false;
+        if (k < trechos.size()) inicio = trechos[k].fim;
+    }
+    return verificador.completo();
+}
+
+// nome do cenário
+inline std::string_view NomeDoCenario(std::string_view trecho) {
+    TokenizadorXML tokens(trecho);
+    EventoXML evento;
+    while (tokens.proximo(evento)) {
+        if (evento.tipo == TipoEvento::Abertura && evento.tag == TAG_NOME) {
+            return evento.valor;
+        }
+    }
+    return std::string_view();
+}
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef LEITOR_FLUXO_H
+#define LEITOR_FLUXO_H
+
+#include <sys/stat.h>  // stat
+#include <unistd.h>  // read
+
+#include <cerrno>  // errno, EINTR
+#include <cstddef>  // std::size_t
+#include <cstring>  // std::memmove
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cenario.h"
+#include "tokenizador_xml.h"
+
+//! Tamanho padrão de cada leitura do fluxo (64 KiB)
+constexpr std::size_t TAMANHO_BLOCO_FLUXO = std::size_t(1) << 16;
+
+//! CLASSE LEITOR FLUXO
+//! Leitura do XML de um descritor que não pode ser mapeado (pipe, entrada
+//! padrão), em blocos de tamanho fixo. Cada bloco é tokenizado até o
+//! último '<' recebido: a partir dele a tag (ou o valor dela) pode estar
+//! pela metade, então esse resto fica no buffer até o próximo bloco. O
+//! texto já tokenizado é descartado, exceto o do cenário atual (nome e
+//! matriz são visões sobre o buffer), então o pico de memória acompanha o
+//! maior cenário, e não o fluxo inteiro.
+class LeitorFluxo {
+ public:
+    //! construtor: lê o descritor 'fd' em blocos de 'tamanho_bloco' bytes
+    explicit LeitorFluxo(int fd, std::size_t tamanho_bloco = TAMANHO_BLOCO_FLUXO);
+    //! metodo lê o fluxo até o fim, entregando cada cenário a 'ao_ler'
+    //! assim que o seu </cenario> chega; mesmo retorno de LerCenarios
+    template <typename Funcao>
+    bool ler(Funcao ao_ler);
+    //! metodo verifica se a leitura parou por erro do descritor
+    bool falhou() const;
+
+ private:
+    //! descarta o texto antes de 'inicio' que 'atual' não usa e garante
+    //! espaço para um bloco; retorna a nova posição de 'inicio'
+    std::size_t prepara(std::size_t inicio, Cenario& atual);
+    //! lê um bloco no fim do buffer; false no fim do fluxo ou em erro
+    bool le_bloco();
+
+    int fd_;
+    std::size_t tamanho_bloco_;
+    std::vector<char> buffer_;
+    std::size_t usados_;  // bytes válidos no início do buffer
+    bool falhou_;
+};
+
+//! Verifica se 'caminho' é um pipe ou dispositivo (por exemplo, o
+//! /dev/fd/N de uma substituição de processo), que não tem o que mapear
+bool EhFluxo(const std::string& caminho);
+
+// construtor
+inline LeitorFluxo::LeitorFluxo(int fd, std::size_t tamanho_bloco) {
+    fd_ = fd;
+    tamanho_bloco_ = tamanho_bloco > 0 ? tamanho_bloco : 1;
+    usados_ = 0;
+    falhou_ = false;
+}
+
+// lê os cenários do fluxo
+// Fora do fim do fluxo, o limite da tokenização é o último '<' do bloco
+// novo: as tags antes dele estão inteiras e o valor de cada uma termina
+// num '<' já recebido, então os eventos são os mesmos de LerCenarios
+// sobre o texto todo. Se o bloco não trouxe '<', nada fica pronto.
+template <typename Funcao>
+bool LeitorFluxo::ler(Funcao ao_ler) {
+    VerificadorAninhamento verificador;
+    Cenario atual;
+    EventoXML evento;
+    std::size_t inicio = 0;  // primeiro byte ainda não tokenizado
+    bool fim = false;
+
+    while (!fim) {
+        inicio = prepara(inicio, atual);
+        std::size_t antes = usados_;
+        fim = !le_bloco();
+        if (falhou_) return false;
+
+        std::size_t limite = usados_;
+        if (!fim) {
+            limite = inicio;
+            for (std::size_t i = usados_; i > antes; i--) {
+                if (buffer_[i - 1] == '<') {
+                    limite = i - 1;
+                    break;
+                }
+            }
+        }
+        if (limite == inicio && !fim) continue;
+
+        std::string_view texto(buffer_.data(), limite);
+        TokenizadorXML tokens(texto, inicio);
+        while (tokens.proximo(evento)) {
+            if (!ProcessaEventoCenario(evento, verificador, atual, ao_ler)) return false;
+        }
+        // Erro: tag não fechada ou com '<' dentro dela
+        if (evento.tipo == TipoEvento::Erro) return false;
+        inicio = limite;
+    }
+    return verificador.completo();
+}
+
+// parou por erro
+inline bool LeitorFluxo::falhou() const {
+    return falhou_;
+}
+
+// descarta o texto já usado e abre espaço para o próximo bloco
+inline std::size_t LeitorFluxo::prepara(std::size_t inicio, Cenario& atual) {
+    // O nome e a matriz do cenário atual continuam em uso até o próximo
+    // <cenario> (que chama limpa()); as visões guardam só a posição
+    const char* base = buffer_.data();
+    auto posicao = [&](std::string_view v) {
+        bool no_buffer = !v.empty() && v.data() >= base && v.data() < base + usados_;
+        return no_buffer ? std::size_t(v.data() - base) : usados_;
+    };
+    std::size_t nome = posicao(atual.nome), matriz = posicao(atual.matriz);
+    bool tem_nome = nome < usados_, tem_matriz = matriz < usados_;
+    std::size_t corte = inicio;
+    if (nome < corte) corte = nome;
+    if (matriz < corte) corte = matriz;
+
+    if (corte > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + corte, usados_ - corte);
+        usados_ -= corte;
+    }
+    if (buffer_.size() < usados_ + tamanho_bloco_) {
+        std::size_t tamanho = 2 * buffer_.size();
+        if (tamanho < usados_ + tamanho_bloco_) tamanho = usados_ + tamanho_bloco_;
+        buffer_.resize(tamanho);
+    }
+    // As visões passam para a nova posição do texto
+    if (tem_nome) {
+        atual.nome = std::string_view(buffer_.data() + nome - corte, atual.nome.size());
+    }
+    if (tem_matriz) {
+        atual.matriz = std::string_view(buffer_.data() + matriz - corte, atual.matriz.size());
+    }
+    return inicio - corte;
+}
+
+// lê um bloco
+inline bool LeitorFluxo::le_bloco() {
+    while (true) {
+        ssize_t lidos = read(fd_, buffer_.data() + usados_, tamanho_bloco_);
+        if (lidos > 0) {
+            usados_ += static_cast<std::size_t>(lidos);
+            return true;
+        }
+        if (lidos == 0) return false;  // fim do fluxo
+        if (errno != EINTR) {
+            falhou_ = true;
+            return false;
+        }
+    }
+}
+
+// pipe ou dispositivo
+inline bool EhFluxo(const std::string& caminho) {
+    struct stat info;
+    if (stat(caminho.c_str(), &info) != 0) return false;
+    return S_ISFIFO(info.st_mode) || S_ISCHR(info.st_mode);
+}
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef LINHA_DO_TEMPO_H
+#define LINHA_DO_TEMPO_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint32_t, std::int64_t
+#include <vector>
+
+#include "area_incremental.h"  // Edicao
+#include "grid.h"
+#include "uniao_busca.h"
+#include "vizinhanca.h"
+
+//! CLASSE LINHA DO TEMPO
+//! Respostas offline para uma linha do tempo de obstáculos: a área do
+//! robô antes do primeiro obstáculo e depois de cada um. A união-busca
+//! não sabe separar conjuntos, mas sabe unir, então os passos são
+//! desfeitos de trás para frente: o mapa final (com todos os obstáculos)
+//! é rotulado uma vez e cada passo desfeito libera uma célula, unida às
+//! vizinhas livres. As T respostas saem em tempo quase linear, em vez de
+//! T preenchimentos do mapa inteiro.
+class LinhaDoTempo {
+ public:
+    //! construtor padrao
+    LinhaDoTempo();
+    //! metodo preenche 'areas' (obstaculos.size() + 1 valores) com a área
+    //! a partir de (x, y) antes dos obstáculos e depois de cada um. Só
+    //! set(x, y, 0) faz sentido aqui; posições fora do mapa e células já
+    //! ocupadas não mudam nada.
+    void calcula(const Grid& mapa, std::size_t x, std::size_t y,
+                 const std::vector<Edicao>& obstaculos, int conectividade,
+                 std::vector<std::int64_t>& areas);
+
+ private:
+    template <typename Vizinhanca>
+    void desfaz(const std::vector<Edicao>& obstaculos, std::size_t x, std::size_t y,
+                std::vector<std::int64_t>& areas);
+    //! une a célula (i, j) às vizinhas livres
+    template <typename Vizinhanca>
+    void une_vizinhas(std::size_t i, std::size_t j);
+
+    Grid mapa_;  // mapa no passo atual (começa no final)
+    UniaoBusca conjuntos_;  // um elemento por célula
+    std::vector<std::uint8_t> efetivo_;  // o passo ocupou uma célula livre
+};
+
+// construtor padrao
+inline LinhaDoTempo::LinhaDoTempo() {}
+
+// calcula as áreas de todos os passos
+inline void LinhaDoTempo::calcula(const Grid& mapa, std::size_t x, std::size_t y,
+                                  const std::vector<Edicao>& obstaculos,
+                                  int conectividade, std::vector<std::int64_t>& areas) {
+    mapa_.redimensiona(mapa.altura(), mapa.largura());
+    for (std::size_t i = 0; i < mapa.altura(); i++) {
+        for (std::size_t k = 0; k < mapa.palavras_por_linha(); k++) {
+            mapa_.linha(i)[k] = mapa.linha(i)[k];
+        }
+    }
+    if (conectividade == 8) {
+        desfaz<Vizinhanca8>(obstaculos, x, y, areas);
+    } else {
+        desfaz<Vizinhanca4>(obstaculos, x, y, areas);
+    }
+}
+
+// Avança até o mapa final, rotula e volta passo a passo
+template <typename Vizinhanca>
+void LinhaDoTempo::desfaz(const std::vector<Edicao>& obstaculos, std::size_t x,
+                          std::size_t y, std::vector<std::int64_t>& areas) {
+    const std::size_t altura = mapa_.altura(), largura = mapa_.largura();
+    // Só os passos que ocupam uma célula ainda livre mudam o mapa
+    efetivo_.assign(obstaculos.size(), 0);
+    for (std::size_t t = 0; t < obstaculos.size(); t++) {
+        const Edicao& e = obstaculos[t];
+        if (e.livre || e.x >= altura || e.y >= largura || !mapa_.get(e.x, e.y)) continue;
+        efetivo_[t] = 1;
+        mapa_.reset(e.x, e.y);
+    }
+
+    // Rotulação do mapa final: cada célula livre unida às de cima e da
+    // esquerda (e, com diagonais, às duas diagonais de cima)
+    conjuntos_.clear();
+    for (std::size_t k = 0; k < altura * largura; k++) conjuntos_.cria();
+    for (std::size_t i = 0; i < altura; i++) {
+        for (std::size_t j = 0; j < largura; j++) {
+            if (!mapa_.get(i, j)) continue;
+            std::uint32_t celula = static_cast<std::uint32_t>(i * largura + j);
+            if (j > 0 && mapa_.get(i, j - 1)) conjuntos_.une(celula, celula - 1);
+            if (i == 0) continue;
+            std::uint32_t cima = static_cast<std::uint32_t>(celula - largura);
+            if (mapa_.get(i - 1, j)) conjuntos_.une(celula, cima);
+            if constexpr (Vizinhanca::diagonais) {
+                if (j > 0 && mapa_.get(i - 1, j - 1)) conjuntos_.une(celula, cima - 1);
+                if (j + 1 < largura && mapa_.get(i - 1, j + 1)) conjuntos_.une(celula, cima + 1);
+            }
+        }
+    }
+
+    auto area_robo = [&]() -> std::int64_t {
+        if (x >= altura || y >= largura || !mapa_.get(x, y)) return 0;
+        return conjuntos_.tamanho(static_cast<std::uint32_t>(x * largura + y));
+    };
+    areas.resize(obstaculos.size() + 1);
+    areas[obstaculos.size()] = area_robo();
+    for (std::size_t t = obstaculos.size(); t-- > 0; ) {
+        if (efetivo_[t]) {
+            const Edicao& e = obstaculos[t];
+            mapa_.set(e.x, e.y);
+            une_vizinhas<Vizinhanca>(e.x, e.y);
+        }
+        areas[t] = area_robo();
+    }
+}
+
+// une a célula liberada às vizinhas livres
+template <typename Vizinhanca>
+void LinhaDoTempo::une_vizinhas(std::size_t i, std::size_t j) {
+    const std::size_t altura = mapa_.altura(), largura = mapa_.largura();
+    std::uint32_t celula = static_cast<std::uint32_t>(i * largura + j);
+    ParaCadaVizinho<Vizinhanca>([&](int dx, int dy) {
+        std::size_t vi = i + dx, vj = j + dy;  // fora do mapa: dá a volta
+        if (vi < altura && vj < largura && mapa_.get(vi, vj)) {
+            conjuntos_.une(celula, static_cast<std::uint32_t>(vi * largura + vj));
+        }
+    });
+}
+
+#endif
@@ -1,240 +1,709 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>  // from_chars (--bateria)
+#include <cstdint>
+#include <cstdio>  // remove
+#include <cstdlib>  // malloc, free (telemetria)
+#include <filesystem>
 #include <iostream>
-#include <fstream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
-#include "array_stack.h"  // Incluindo o arquivo da estrutura de pilha
-#include "array_queue.h"  // Incluindo o arquivo da estrutura de fila
+#include <vector>
+#include <fcntl.h>  // open (entrada em fluxo)
+#include <unistd.h>  // close
+#include "arquivo_mapeado.h"  // Leitura do XML por mapeamento em memória
+#include "leitor_fluxo.h"  // Leitura do XML em blocos, de pipes e de cin
+#include "tokenizador_xml.h"  // Tokenizador de tags do XML
+#include "cenario.h"  // Cenario e leitura/verificação do XML
+#include "grid.h"  // Matriz de ocupação com 1 bit por célula
+#include "preenchimento.h"  // Motores de cálculo da área limpa
+#include "rotulacao.h"  // Componentes conexas (vários robôs no mesmo mapa)
+#include "paralelo.h"  // Pool de threads e buffer de reordenação
+#include "indice_cenarios.h"  // Pré-varredura dos trechos de cada cenário
+#include "cenb.h"  // Formato binário .cenb
+#include "cache_areas.h"  // Cache persistente de áreas já calculadas
+#include "area_incremental.h"  // Áreas mantidas ao longo de edições do mapa
+#include "linha_do_tempo.h"  // Linha do tempo de obstáculos, de trás para frente
+#include "bateria.h"  // Área alcançável com bateria limitada
+#include "telemetria.h"  // Medidas por cenário (-DTELEMETRIA)
 
 using namespace std;
-using namespace structures;  // Permite acessar as classes e funções da pilha
-
-class Cenario {
-  public:
-    Cenario(string& texto, size_t indice_inicial) {
-        size_t pos = indice_inicial;
-        nome = proxima_tag_conteudo(texto, pos, "nome");
-        altura = static_cast<size_t>( stoi( proxima_tag_conteudo(texto, pos, "altura") ) );
-        largura = static_cast<size_t>( stoi( proxima_tag_conteudo(texto, pos, "largura") ) );
-        x = static_cast<size_t>( stoi( proxima_tag_conteudo(texto, pos, "x") ) );
-        y = static_cast<size_t>( stoi( proxima_tag_conteudo(texto, pos, "y") ) );
-        matriz = matriz_remove_espacos( proxima_tag_conteudo(texto, pos, "matriz") );
-        indice_final = pos;
-    }
-    ~Cenario() {};
-    string nome;
-    size_t altura;
-    size_t largura;
-    size_t x;
-    size_t y;
-    string matriz;
-    size_t indice_final;
-
-  private:
-    string proxima_tag(string& texto, size_t& pos) {
-        string tag = "";
-        for ( ; pos < texto.length(); pos++) {
-            if (texto[pos] == '<') {
-                pos++;
-                while (texto[pos] != '>') {
-                    tag += texto[pos];
-                    pos++;
-                }
-                pos++;
-                return tag;
-            }
-        }
-        return tag;
-    }
-    string proximo_conteudo(string& texto, size_t& pos) {
-        string txt = "";
-        while (texto[pos] != '<') {
-            txt += texto[pos];
-            pos++;
-        }
-        while (texto[pos] != '>') {
-            pos++;
-        }
-        pos++;
-        return txt;
-    }
-    string proxima_tag_conteudo(string& texto, size_t& pos, string nome_tag) {
-        string tag = "";
-        while (tag != nome_tag) {
-            tag = proxima_tag(texto, pos);
-        }
-        return proximo_conteudo(texto, pos);
+
+#ifdef TELEMETRIA
+// operator new que soma os bytes pedidos por cada thread (telemetria.h).
+// Fora de linha, para o compilador não casar o free() com o operator new.
+__attribute__((noinline)) void* operator new(size_t tamanho) {
+    BytesAlocadosThread() += tamanho;
+    if (void* p = malloc(tamanho > 0 ? tamanho : 1)) return p;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+#endif
+
+// Opções da linha de comando
+struct Opcoes {
+    Motor motor = Motor::BFS;
+    size_t threads = 1;
+    string_view apenas;  // nome do único cenário a processar (vazio: todos)
+    string converter;  // arquivo .cenb a gerar a partir do XML (vazio: nenhum)
+    CacheAreas* cache = nullptr;  // cache de áreas (--cache), comum às threads
+    const vector<Edicao>* edicoes = nullptr;  // roteiro de --edicoes
+    const vector<Edicao>* obstaculos = nullptr;  // linha do tempo de --obstaculos
+    vector<size_t> baterias;  // limites de movimentos de --bateria
+    TELEMETRIA_CONTA(RegistroTelemetria* telemetria = nullptr;)  // --telemetria
+};
+
+// Memória de trabalho reaproveitada de um cenário para o outro, e de um
+// arquivo para o outro no modo em lote (uma por thread quando os cenários
+// são processados em paralelo)
+struct Recursos {
+    Grid mapa;
+    Componentes componentes;  // usado pelos cenários com <robos>
+    vector<uint32_t> rotulos;
+    MemoriaPreenchimento memoria;  // visitadas e filas dos motores
+    AreaIncremental incremental;  // usado com --edicoes
+    LinhaDoTempo linha_do_tempo;  // usado com --obstaculos
+    vector<int64_t> areas;
+    // Fim do cenário anterior (ou início da leitura), para a telemetria
+    TELEMETRIA_CONTA(uint64_t marca_ns = 0;)
+    TELEMETRIA_CONTA(size_t marca_bytes = 0;)
+};
+
+// Marca o início da leitura de um trecho (telemetria)
+inline void MarcaLeitura(Recursos& recursos) {
+    TELEMETRIA_CONTA(recursos.marca_ns = AgoraNs();)
+    TELEMETRIA_CONTA(recursos.marca_bytes = BytesAlocadosThread();)
+    (void) recursos;
+}
+
+// Cenário com <robos>: uma única rotulação do mapa responde a todos os
+// robôs. Escreve "nome a1 a2 ... an uniao", com a área de cada robô na
+// ordem do XML e, por último, a área coberta por pelo menos um deles (a
+// soma das componentes distintas alcançadas).
+void EscreveCenarioRobos(const Cenario& c, Recursos& recursos, string& saida) {
+    Componentes& componentes = recursos.componentes;
+    vector<uint32_t>& rotulos = recursos.rotulos;
+    componentes.rotula(recursos.mapa, c.conectividade);
+    rotulos.clear();
+    saida.append(c.nome);
+    for (const pair<size_t, size_t>& robo : c.robos) {
+        int x = static_cast<int>(robo.first);
+        int y = static_cast<int>(robo.second);
+        uint32_t r = componentes.rotulo(x, y);
+        if (r != 0) rotulos.push_back(r);
+        saida += ' ';
+        saida += to_string(componentes.area_rotulo(r));
     }
-    string matriz_remove_espacos(string texto) {
-        string saida;
-        for (int i = 0; i < texto.length(); i++) {
-            if (texto[i] == '0' || texto[i] == '1') {
-                saida += texto[i];
-            }
+    sort(rotulos.begin(), rotulos.end());
+    int uniao = 0;
+    for (size_t i = 0; i < rotulos.size(); i++) {
+        if (i == 0 || rotulos[i] != rotulos[i - 1]) {
+            uniao += componentes.area_rotulo(rotulos[i]);
         }
-        return saida;
     }
-};
-
-bool verificarAninhamentoXML(string& texto) {
-    ArrayStack<string> pilha;
-    size_t i = 0;
-
-    while (i < texto.size()) {
-        if (texto[i] == '<') {
-            // Procura a tag de fechamento a partir da posição i
-            size_t j = texto.find('>', i);
-            // Verifica se a busca falhou (retornou npos)
-            if (j == string::npos) {
-                // Erro: Tag não fechada
-                return false;
-            }
+    saida += ' ';
+    saida += to_string(uniao);
+    saida += '\n';
+}
 
-            // Extrai o nome da tag
-            string tag = texto.substr(i+1, j-i-1);
+// Cenário com --edicoes: escreve "nome a0 a1 ... an", com a área antes
+// das edições e depois de cada uma delas, em ordem. O mapa é rotulado uma
+// vez e as componentes acompanham as edições (AreaIncremental).
+void EscreveCenarioEditado(const Cenario& c, Recursos& recursos,
+                           const vector<Edicao>& edicoes, string& saida) {
+    AreaIncremental& incremental = recursos.incremental;
+    incremental.inicia(recursos.mapa, c.conectividade);
+    saida.append(c.nome);
+    saida += ' ';
+    saida += to_string(incremental.area(c.x, c.y));
+    for (const Edicao& edicao : edicoes) {
+        incremental.aplica(edicao);
+        saida += ' ';
+        saida += to_string(incremental.area(c.x, c.y));
+    }
+    saida += '\n';
+}
 
-             // Verifica se a tag possui um '<' dentro dela
-            if (tag.find('<', i) != string::npos) return false;
+// Cenário com --obstaculos: a mesma linha de EscreveCenarioEditado, mas
+// com as respostas calculadas offline, do último passo para o primeiro
+void EscreveCenarioLinhaDoTempo(const Cenario& c, Recursos& recursos,
+                                const vector<Edicao>& obstaculos, string& saida) {
+    recursos.linha_do_tempo.calcula(recursos.mapa, c.x, c.y, obstaculos,
+                                    c.conectividade, recursos.areas);
+    saida.append(c.nome);
+    for (int64_t area : recursos.areas) {
+        saida += ' ';
+        saida += to_string(area);
+    }
+    saida += '\n';
+}
 
-            if (!tag.empty() && tag[0] == '/') {
-                // É uma tag de fechamento 
-                if (pilha.empty() || pilha.top() != tag.substr(1)) {
-                    // Se a pilha não conter a tag de abertura
-                    // Ou se tentamos fechar uma tag que não é a esperada
-                    return false; // Erro de aninhamento
-                }
-                pilha.pop();
-            } else {
-                // É uma tag de abertura
-                pilha.push(tag);
-            }
-            i = j; // Move para depois de '>'
-        }
-        i++;
+// Cenário de um robô com --bateria: escreve "nome area a1 ... an", com a
+// área sem limite e a alcançável com cada bateria, na ordem da opção. Uma
+// única expansão da fronteira dá o histograma de todas as distâncias.
+void EscreveCenarioBateria(const Cenario& c, Recursos& recursos,
+                           const vector<size_t>& baterias, string& saida) {
+    CalcularHistogramaDistancias(recursos.mapa, c.x, c.y, recursos.memoria,
+                                 recursos.areas, c.conectividade);
+    saida.append(c.nome);
+    saida += ' ';
+    saida += to_string(recursos.areas.empty() ? 0 : recursos.areas.back());
+    for (size_t k : baterias) {
+        saida += ' ';
+        saida += to_string(AreaComBateria(recursos.areas, k));
     }
-    return pilha.empty();  // Se a pilha estiver vazia, o XML está bem aninhado
+    saida += '\n';
 }
 
-char** CriaMatriz(string& texto, int linhas, int colunas, bool zeros) {
-    char** matriz = new char*[linhas];
-    for (size_t i = 0; i < linhas; i++) {
-        matriz[i] = new char[colunas];
-        for (size_t j = 0; j < colunas; j++) {
-            if (!zeros) {
-                matriz[i][j] = texto[i*colunas + j];
-            } else {
-                matriz[i][j] = 0;
-            }
+// O motor Trechos lê o <matriz> direto em trechos (GridRLE), sem passar
+// pelo Grid, quando o mapa em bits não é usado por mais nada: nem pelos
+// robôs de <robos>, nem pela chave do cache, nem pelas edições, pela
+// linha do tempo ou pela bateria, nem vem pronto de um .cenb.
+bool LeEmTrechos(const Cenario& c, const Opcoes& opcoes) {
+    return opcoes.motor == Motor::Trechos && c.bits == nullptr &&
+           !c.lista_robos && opcoes.cache == nullptr &&
+           opcoes.edicoes == nullptr && opcoes.obstaculos == nullptr &&
+           opcoes.baterias.empty();
+}
+
+// Cenário com um único robô: escreve "nome area". Com --cache, a área
+// de um mapa e posição já vistos vem do cache, sem preenchimento; os
+// cenários com <robos> sempre são calculados (uma rotulação já responde
+// a todos os robôs).
+void EscreveCenarioUnico(const Cenario& c, Recursos& recursos, const Opcoes& opcoes,
+                         size_t threads_mapa, string& saida) {
+    int64_t area;
+    if (LeEmTrechos(c, opcoes)) {
+        area = CalcularAreaTrechos(recursos.memoria.trechos, c.x, c.y,
+                                   recursos.memoria, c.conectividade);
+    } else if (opcoes.cache == nullptr) {
+        area = CalcularAreaLimpeza(recursos.mapa, c.x, c.y, opcoes.motor,
+                                   threads_mapa, recursos.memoria, c.conectividade);
+    } else {
+        ChaveCenario chave = CalculaChave(recursos.mapa, c.x, c.y, c.conectividade);
+        if (!opcoes.cache->busca(chave, area)) {
+            area = CalcularAreaLimpeza(recursos.mapa, c.x, c.y, opcoes.motor, threads_mapa,
+                                       recursos.memoria, c.conectividade);
+            opcoes.cache->guarda(chave, area);
         }
     }
-    return matriz;
+    saida.append(c.nome);
+    saida += ' ';
+    saida += to_string(area);
+    saida += '\n';
 }
 
-void DestroiMatriz(char** &matriz, int altura) {
-    for (size_t i = 0; i < altura; i++) {
-        delete[] matriz[i];
+// Calcula a área de um cenário e anexa a linha de resultado a 'saida'.
+// 'threads_mapa' é o número de threads usadas dentro de um único mapa
+// (só pelo motor Ladrilhos). Compilado com -DTELEMETRIA, mede também
+// cada etapa do cenário e escreve uma linha JSON em --telemetria.
+void ProcessaCenario(const Cenario& c, Recursos& recursos, const Opcoes& opcoes,
+                     size_t threads_mapa, string& saida) {
+#ifdef TELEMETRIA
+    Telemetria medida;
+    uint64_t t0 = AgoraNs();
+    medida.leitura_ns = t0 - recursos.marca_ns;
+#endif
+    if (c.bits != nullptr) {
+        // Cenário de um .cenb: o mapa é lido direto do arquivo mapeado
+        recursos.mapa.aponta(c.bits, c.altura, c.largura);
+    } else if (LeEmTrechos(c, opcoes)) {
+        recursos.memoria.trechos.carrega(c.matriz, c.altura, c.largura);
+    } else {
+        recursos.mapa.carrega(c.matriz, c.altura, c.largura);
+    }
+#ifdef TELEMETRIA
+    uint64_t t1 = AgoraNs();
+    medida.carga_ns = t1 - t0;
+    recursos.memoria.estatisticas.zera();
+#endif
+    if (c.lista_robos) {
+        EscreveCenarioRobos(c, recursos, saida);
+        TELEMETRIA_CONTA(recursos.memoria.estatisticas.visitadas = c.altura * c.largura;)
+    } else if (opcoes.edicoes != nullptr) {
+        EscreveCenarioEditado(c, recursos, *opcoes.edicoes, saida);
+    } else if (opcoes.obstaculos != nullptr) {
+        EscreveCenarioLinhaDoTempo(c, recursos, *opcoes.obstaculos, saida);
+    } else if (!opcoes.baterias.empty()) {
+        EscreveCenarioBateria(c, recursos, opcoes.baterias, saida);
+    } else {
+        EscreveCenarioUnico(c, recursos, opcoes, threads_mapa, saida);
     }
-    delete[] matriz;
-    matriz = nullptr;  
+#ifdef TELEMETRIA
+    medida.preenchimento_ns = AgoraNs() - t1;
+    medida.bytes_alocados = BytesAlocadosThread() - recursos.marca_bytes;
+    medida.preenchimento = recursos.memoria.estatisticas;
+    if (opcoes.telemetria != nullptr) opcoes.telemetria->escreve(c.nome, medida);
+#endif
+    MarcaLeitura(recursos);  // a leitura do próximo cenário começa aqui
 }
 
-int CalcularAreaLimpeza(string& matriz_texto, int x0, int y0, int altura, int largura) {
-    char** matriz = CriaMatriz(matriz_texto, altura, largura, 0);
-
-    if (matriz[x0][y0] == '0') return 0;
+// Caminho principal: verificação e leitura em uma só passada pelo XML,
+// processando cada cenário assim que ele é lido
+bool ProcessaSequencial(string_view texto, const Opcoes& opcoes,
+                        vector<Recursos>& recursos, string& saida) {
+    // No motor Ladrilhos, as threads ficam com as faixas de cada mapa
+    size_t threads_mapa = opcoes.motor == Motor::Ladrilhos ? opcoes.threads : 1;
+    MarcaLeitura(recursos[0]);
+    return LerCenarios(texto, [&](const Cenario& c) {
+        if (!opcoes.apenas.empty() && c.nome != opcoes.apenas) return;
+        ProcessaCenario(c, recursos[0], opcoes, threads_mapa, saida);
+    });
+}
 
-    // Matriz R para controlar os pontos visitados
-    char** R = CriaMatriz(matriz_texto, altura, largura, 1);
+// Caminho das entradas que não podem ser mapeadas (pipe, --fluxo): o XML
+// chega em blocos de tamanho fixo e cada cenário é processado assim que o
+// seu </cenario> é lido, sem esperar pelo resto do fluxo. É sempre
+// sequencial, como ProcessaSequencial (não há índice sem o texto todo).
+bool ProcessaFluxo(LeitorFluxo& leitor, const Opcoes& opcoes,
+                   vector<Recursos>& recursos, string& saida) {
+    size_t threads_mapa = opcoes.motor == Motor::Ladrilhos ? opcoes.threads : 1;
+    if (recursos.empty()) recursos.resize(1);
+    MarcaLeitura(recursos[0]);
+    return leitor.ler([&](const Cenario& c) {
+        if (!opcoes.apenas.empty() && c.nome != opcoes.apenas) return;
+        ProcessaCenario(c, recursos[0], opcoes, threads_mapa, saida);
+    });
+}
 
-    // Definir a fila que aceitará valores do tipo pares de inteiros (coordenadas)
-    ArrayQueue<std::pair<int, int>> fila(altura*largura);  
+// Trecho de um cenário a ser processado por uma thread, com a sua posição no XML
+struct TarefaTrecho {
+    size_t ordem = 0;
+    string_view trecho;
+};
 
-    fila.enqueue({x0, y0});
-    R[x0][y0] = 1;
-    int area = 1;
+// Caminho com índice: os trechos de cada cenário já são conhecidos pela
+// pré-varredura, então cada thread lê, verifica e processa o seu trecho,
+// sem esperar por uma leitura sequencial do XML. O texto fora dos
+// cenários é verificado à parte (VerificaEsqueleto), e os cenários
+// deixados de fora por --only nem chegam a ser lidos.
+bool ProcessaIndexado(string_view texto, const vector<TrechoCenario>& trechos,
+                      const Opcoes& opcoes, vector<Recursos>& recursos,
+                      string& saida) {
+    if (!VerificaEsqueleto(texto, trechos)) return false;
+
+    size_t threads_mapa = opcoes.motor == Motor::Ladrilhos ? opcoes.threads : 1;
+    size_t trabalhadores = threads_mapa > 1 ? 1 : opcoes.threads;
+    BufferOrdenado resultados;
+    atomic<bool> valido(true);
+
+    PoolTrabalho<TarefaTrecho> pool(trabalhadores, 4 * trabalhadores,
+        [&](size_t t, TarefaTrecho& tarefa) {
+            string linha;
+            MarcaLeitura(recursos[t]);
+            bool ok = LerCenarios(tarefa.trecho, [&](const Cenario& c) {
+                ProcessaCenario(c, recursos[t], opcoes, threads_mapa, linha);
+            });
+            if (!ok) valido = false;
+            resultados.coloca(tarefa.ordem, move(linha));
+        });
+    size_t ordem = 0;
+    for (const TrechoCenario& trecho : trechos) {
+        string_view texto_trecho = texto.substr(trecho.inicio, trecho.fim - trecho.inicio);
+        if (!opcoes.apenas.empty() && NomeDoCenario(texto_trecho) != opcoes.apenas) continue;
+        TarefaTrecho tarefa;
+        tarefa.ordem = ordem++;
+        tarefa.trecho = texto_trecho;
+        pool.submete(tarefa);
+    }
+    pool.termina();
+    resultados.escreve(saida);
+    return valido;
+}
 
-    // Vetores de deslocamento para as 4 direções possíveis (vizinhança-4)
-    int dx[] = {-1, 1, 0, 0}; // Movimentos Verticais 
-    int dy[] = {0, 0, -1, 1}; // Movimentos Horizontais
+// Cenário a ser processado por uma thread, com a sua posição no arquivo
+struct TarefaCenario {
+    size_t ordem = 0;
+    Cenario cenario;
+};
 
-    while (!fila.empty()) {
-        pair<int, int> posicao_atual = fila.dequeue();
+// Caminho do formato binário: os cenários vêm prontos do .cenb, sem
+// leitura de texto, e os mapas são usados direto do arquivo mapeado
+bool ProcessaCenb(string_view dados, const Opcoes& opcoes,
+                  vector<Recursos>& recursos, string& saida) {
+    size_t threads_mapa = opcoes.motor == Motor::Ladrilhos ? opcoes.threads : 1;
+    size_t trabalhadores = threads_mapa > 1 ? 1 : opcoes.threads;
+    if (trabalhadores == 1) {
+        MarcaLeitura(recursos[0]);
+        return LerCenariosCenb(dados, [&](const Cenario& c) {
+            if (!opcoes.apenas.empty() && c.nome != opcoes.apenas) return;
+            ProcessaCenario(c, recursos[0], opcoes, threads_mapa, saida);
+        });
+    }
 
-        int x = posicao_atual.first;
-        int y = posicao_atual.second;
+    BufferOrdenado resultados;
+    PoolTrabalho<TarefaCenario> pool(trabalhadores, 4 * trabalhadores,
+        [&](size_t t, TarefaCenario& tarefa) {
+            string linha;
+            MarcaLeitura(recursos[t]);
+            ProcessaCenario(tarefa.cenario, recursos[t], opcoes, 1, linha);
+            resultados.coloca(tarefa.ordem, move(linha));
+        });
+    size_t ordem = 0;
+    bool valido = LerCenariosCenb(dados, [&](const Cenario& c) {
+        if (!opcoes.apenas.empty() && c.nome != opcoes.apenas) return;
+        TarefaCenario tarefa;
+        tarefa.ordem = ordem++;
+        tarefa.cenario = c;
+        pool.submete(tarefa);
+    });
+    pool.termina();
+    resultados.escreve(saida);
+    return valido;
+}
 
-        for (int i = 0; i < 4; i++) {
-            int novo_x = x + dx[i];
-            int novo_y = y + dy[i];
+// Escolhe o caminho de processamento de um arquivo já mapeado (XML ou
+// .cenb) e anexa as linhas de resultado a 'saida'. Retorna false se o XML
+// estiver mal aninhado (ou o .cenb corrompido).
+bool ProcessaTexto(string_view texto, const Opcoes& opcoes,
+                   vector<Recursos>& recursos, string& saida) {
+    size_t threads_mapa = opcoes.motor == Motor::Ladrilhos ? opcoes.threads : 1;
+    size_t trabalhadores = threads_mapa > 1 ? 1 : opcoes.threads;
+    if (recursos.size() < trabalhadores) recursos.resize(trabalhadores);
+
+    vector<TrechoCenario> trechos;
+    bool usa_indice = (opcoes.threads > 1 && opcoes.motor != Motor::Ladrilhos) ||
+                      !opcoes.apenas.empty();
+    if (EhCenb(texto)) return ProcessaCenb(texto, opcoes, recursos, saida);
+    if (usa_indice && IndexaCenarios(texto, trechos)) {
+        return ProcessaIndexado(texto, trechos, opcoes, recursos, saida);
+    }
+    // Sem índice (ou com <cenario> fora do padrão, que a pré-varredura
+    // não sabe dividir): uma única passada pelo XML
+    return ProcessaSequencial(texto, opcoes, recursos, saida);
+}
 
-            if (novo_x >= 0 && novo_x < altura &&   // Posições válidas
-                novo_y >= 0 && novo_y < largura &&
-                R[novo_x][novo_y] == 0 &&           
-                matriz[novo_x][novo_y] == '1') {
+// Acrescenta a 'arquivos' um caminho dado ao modo em lote: um diretório
+// entra com os seus arquivos .xml e .cenb, em ordem alfabética
+void AdicionaEntrada(const string& caminho, vector<string>& arquivos) {
+    error_code erro;
+    if (!filesystem::is_directory(caminho, erro)) {
+        arquivos.push_back(caminho);
+        return;
+    }
+    vector<string> encontrados;
+    for (const filesystem::directory_entry& entrada :
+         filesystem::directory_iterator(caminho, erro)) {
+        string extensao = entrada.path().extension().string();
+        if (entrada.is_regular_file(erro) && (extensao == ".xml" || extensao == ".cenb")) {
+            encontrados.push_back(entrada.path().string());
+        }
+    }
+    sort(encontrados.begin(), encontrados.end());
+    arquivos.insert(arquivos.end(), encontrados.begin(), encontrados.end());
+}
 
-                fila.enqueue({novo_x, novo_y});
-                R[novo_x][novo_y] = 1; // Marca o lugar da nova matriz como visitado
-                area++;
-            }
+// Modo em lote: vários arquivos em um só processo. A memória de trabalho
+// (Recursos) passa de um arquivo para o outro, e toda a saída vai por um
+// único buffer, despejado em blocos grandes, sem esvaziar o cout a cada
+// linha. Cada arquivo começa com a linha "==> nome <==" e, se estiver mal
+// aninhado, tem "erro" como resultado; com --cache, as áreas calculadas
+// nele são descartadas, como no caminho de um único arquivo.
+int ProcessaLote(const vector<string>& arquivos, const Opcoes& opcoes) {
+    const size_t LIMITE_BUFFER = size_t(1) << 20;
+    vector<Recursos> recursos(1);
+    string saida;
+    int status = 0;
+    for (const string& nome : arquivos) {
+        ArquivoMapeado arquivo(nome);
+        if (!arquivo.is_open()) {
+            cerr << "Erro ao abrir o arquivo " << nome << '\n';
+            status = 1;
+            continue;
+        }
+        saida += "==> ";
+        saida += nome;
+        saida += " <==\n";
+        size_t inicio = saida.size();
+        size_t pendentes = opcoes.cache != nullptr ? opcoes.cache->pendentes() : 0;
+        if (!ProcessaTexto(arquivo.conteudo(), opcoes, recursos, saida)) {
+            saida.resize(inicio);
+            saida += "erro\n";
+            if (opcoes.cache != nullptr) opcoes.cache->descarta(pendentes);
+        }
+        if (saida.size() >= LIMITE_BUFFER) {
+            cout.write(saida.data(), saida.size());
+            saida.clear();
         }
     }
+    cout.write(saida.data(), saida.size());
+    return status;
+}
 
-    for (size_t i = 0; i < altura; i++) {
-        delete[] matriz[i];
-        delete[] R[i];
+// Converte o XML para .cenb em vez de calcular as áreas. Se o XML estiver
+// mal aninhado, imprime "erro" e não deixa o arquivo de saída.
+int ConverteParaCenb(string_view texto, const string& caminho) {
+    EscritorCenb escritor(caminho);
+    if (!escritor.is_open()) {
+        cerr << "Erro ao criar o arquivo " << caminho << endl;
+        return 1;
     }
-    delete[] matriz;
-    delete[] R;
+    Grid mapa;
+    bool valido = LerCenarios(texto, [&](const Cenario& c) {
+        mapa.carrega(c.matriz, c.altura, c.largura);
+        escritor.adiciona(c, mapa);
+    });
+    bool gravado = escritor.fecha();
+    if (!valido) {
+        remove(caminho.c_str());
+        cerr << "erro" << endl;
+        return 0;
+    }
+    if (!gravado) {
+        cerr << "Erro ao gravar o arquivo " << caminho << endl;
+        return 1;
+    }
+    return 0;
+}
 
-    // DestroiMatriz(matriz, largura);
-    // DestroiMatriz(R, largura);
+// Lê um roteiro de edições (--edicoes, --obstaculos); em caso de erro,
+// avisa em cerr e retorna false
+bool LeArquivoEdicoes(const string& caminho, vector<Edicao>& edicoes) {
+    ArquivoMapeado roteiro(caminho);
+    if (!roteiro.is_open()) {
+        cerr << "Erro ao abrir o arquivo " << caminho << endl;
+        return false;
+    }
+    size_t linha_erro = 0;
+    if (!LeEdicoes(roteiro.conteudo(), edicoes, linha_erro)) {
+        cerr << "Edicao invalida em " << caminho << ", linha " << linha_erro << endl;
+        return false;
+    }
+    return true;
+}
 
-    return area;
+// Lê a lista "K,K,..." de --bateria; false se vazia ou com algo que não
+// seja número
+bool LeBaterias(string_view lista, vector<size_t>& baterias) {
+    baterias.clear();
+    while (true) {
+        size_t virgula = lista.find(',');
+        string_view parte = lista.substr(0, virgula);
+        size_t k;
+        const char* fim = parte.data() + parte.size();
+        if (parte.empty() || from_chars(parte.data(), fim, k).ptr != fim) return false;
+        baterias.push_back(k);
+        if (virgula == string_view::npos) return true;
+        lista.remove_prefix(virgula + 1);
+    }
 }
 
 /**********************
     FUNÇÃO PRINCIPAL
 ***********************/
-int main() {
-
-    string filename;
-
-    std::cin >> filename;  // nome do arquivo de entrada 
-                           // (no 'executar': escrever pelo teclado;
-                           //  no 'avaliar' : nome é passado pelos testes)
-
-    // Abertura do arquivo
-    ifstream filexml(filename);
-    if (!filexml.is_open()) {
-        cerr << "Erro ao abrir o arquivo " << filename << endl;
-        throw runtime_error("Erro no arquivo XML");
+int main(int argc, char* argv[]) {
+
+    // Opções (todas opcionais; sem elas o comportamento é o do VPL):
+    //   --motor=bfs|varredura|bits|rotulos|ladrilhos|trechos|blocos
+    //                 motor usado no cálculo da área
+    //   --threads=N   processa os cenários em N threads (0: uma por núcleo);
+    //                 com --motor=ladrilhos, as N threads dividem cada mapa
+    //   --only=NOME   processa apenas o cenário NOME
+    //   --converter=ARQUIVO.cenb   grava os cenários do XML no formato binário
+    //   --cache=ARQUIVO   reaproveita as áreas guardadas em ARQUIVO e acrescenta
+    //                     as novas; acertos e faltas saem em cerr no fim
+    //   --telemetria=ARQUIVO   grava uma linha JSON por cenário com os tempos
+    //                     e contadores (só se compilado com -DTELEMETRIA)
+    //   --edicoes=ARQUIVO   aplica a cada cenário de um robô o roteiro de
+    //                     edições "set(x,y,0|1)" e escreve a área depois
+    //                     de cada uma (cenários com <robos> não mudam)
+    //   --obstaculos=ARQUIVO   linha do tempo: um "set(x,y,0)" por passo;
+    //                     a mesma saída de --edicoes, calculada offline
+    //   --bateria=K[,K...]   escreve também a área alcançável em no máximo
+    //                     K movimentos, para cada K (cenários de um robô)
+    //   --fluxo[=BYTES]   lê o próprio XML de cin (em vez do nome do
+    //                     arquivo), em blocos de BYTES (padrão 64 KiB); a
+    //                     memória acompanha o maior cenário, não a entrada
+    //   --lista       modo em lote: lê de cin um nome de arquivo por linha
+    //   ARQUIVO|DIRETORIO ...   modo em lote com os arquivos dados (de um
+    //                     diretório, os .xml e .cenb que estiverem nele)
+    // A entrada pode ser um XML ou um .cenb (reconhecido pela assinatura).
+    // Se o nome lido de cin for um pipe (por exemplo, <(gerador ...)), o
+    // XML é lido em blocos, como com --fluxo.
+    Opcoes opcoes;
+    CacheAreas cache;
+    TELEMETRIA_CONTA(RegistroTelemetria telemetria;)
+    vector<Edicao> edicoes, obstaculos;
+    vector<string> arquivos;
+    bool lista = false;
+    size_t bloco_fluxo = 0;  // --fluxo (0: entrada mapeada)
+    for (int i = 1; i < argc; i++) {
+        string_view opcao = argv[i];
+        if (opcao.substr(0, 2) != "--") {
+            AdicionaEntrada(string(opcao), arquivos);
+            continue;
+        }
+        if (opcao == "--lista") {
+            lista = true;
+            continue;
+        }
+        if (opcao == "--fluxo") {
+            bloco_fluxo = TAMANHO_BLOCO_FLUXO;
+            continue;
+        }
+        if (opcao.substr(0, 8) == "--fluxo=" && le_inteiro(opcao.substr(8), bloco_fluxo) &&
+            bloco_fluxo > 0) {
+            continue;
+        }
+        if (opcao.substr(0, 8) == "--motor=" && motor_de_nome(opcao.substr(8), opcoes.motor)) {
+            continue;
+        }
+        if (opcao.substr(0, 10) == "--threads=" && le_inteiro(opcao.substr(10), opcoes.threads)) {
+            continue;
+        }
+        if (opcao.substr(0, 7) == "--only=" && opcao.size() > 7) {
+            opcoes.apenas = opcao.substr(7);
+            continue;
+        }
+        if (opcao.substr(0, 12) == "--converter=" && opcao.size() > 12) {
+            opcoes.converter = string(opcao.substr(12));
+            continue;
+        }
+#ifdef TELEMETRIA
+        if (opcao.substr(0, 13) == "--telemetria=" && opcao.size() > 13) {
+            if (!telemetria.abre(string(opcao.substr(13)))) {
+                cerr << "Erro ao criar o arquivo " << opcao.substr(13) << endl;
+                return 1;
+            }
+            opcoes.telemetria = &telemetria;
+            continue;
+        }
+#endif
+        if (opcao.substr(0, 10) == "--edicoes=" && opcao.size() > 10) {
+            if (!LeArquivoEdicoes(string(opcao.substr(10)), edicoes)) return 1;
+            opcoes.edicoes = &edicoes;
+            continue;
+        }
+        if (opcao.substr(0, 13) == "--obstaculos=" && opcao.size() > 13) {
+            if (!LeArquivoEdicoes(string(opcao.substr(13)), obstaculos)) return 1;
+            for (const Edicao& e : obstaculos) {
+                if (e.livre) {
+                    cerr << "A linha do tempo so aceita set(x,y,0)" << endl;
+                    return 1;
+                }
+            }
+            opcoes.obstaculos = &obstaculos;
+            continue;
+        }
+        if (opcao.substr(0, 10) == "--bateria=" && LeBaterias(opcao.substr(10), opcoes.baterias)) {
+            continue;
+        }
+        if (opcao.substr(0, 8) == "--cache=" && opcao.size() > 8) {
+            cache.carrega(string(opcao.substr(8)));
+            opcoes.cache = &cache;
+            continue;
+        }
+        cerr << "Opcao invalida: " << opcao << endl;
+        return 1;
+    }
+    if (opcoes.threads == 0) opcoes.threads = max(1u, thread::hardware_concurrency());
+    int roteiros = (opcoes.edicoes != nullptr) + (opcoes.obstaculos != nullptr) +
+                   !opcoes.baterias.empty();
+    if (roteiros > 1) {
+        cerr << "--edicoes, --obstaculos e --bateria nao podem ser usados juntos" << endl;
+        return 1;
     }
 
-    // Leitura do XML completo para 'texto'
-    string texto;
-    char character;
-    while (filexml.get(character)) {
-        texto += character;
+    if ((lista || !arquivos.empty()) && bloco_fluxo > 0) {
+        cerr << "--fluxo nao pode ser usado no modo em lote" << endl;
+        return 1;
     }
 
-    // Verificação de aninhamento de tags XML
-    if (!verificarAninhamentoXML(texto)) {
-        cerr << "erro" << endl;
-        return 0;
+    if (lista) {
+        string linha;
+        while (getline(cin, linha)) {
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            if (!linha.empty()) AdicionaEntrada(linha, arquivos);
+        }
+    }
+    if (lista || !arquivos.empty()) {
+        if (!opcoes.converter.empty()) {
+            cerr << "--converter aceita um unico arquivo" << endl;
+            return 1;
+        }
+        int status = ProcessaLote(arquivos, opcoes);
+        if (opcoes.cache != nullptr) {
+            if (!cache.grava()) cerr << "Erro ao gravar o cache\n";
+            cerr << "cache: " << cache.acertos() << " acertos, "
+                 << cache.faltas() << " faltas\n";
+        }
+        return status;
     }
 
-    size_t ultimo_indice = texto.find_last_of('0');
-    size_t tmp = texto.find_last_of('1');
-    if (tmp > ultimo_indice) {
-        ultimo_indice = tmp;
+    string filename;
+    int fd = 0;  // --fluxo: o XML vem pela entrada padrão
+
+    if (bloco_fluxo == 0) {
+        std::cin >> filename;  // nome do arquivo de entrada 
+                               // (no 'executar': escrever pelo teclado;
+                               //  no 'avaliar' : nome é passado pelos testes)
+
+        // Um pipe não tem o que mapear: é lido em blocos
+        if (EhFluxo(filename)) {
+            fd = open(filename.c_str(), O_RDONLY);
+            if (fd < 0) {
+                cerr << "Erro ao abrir o arquivo " << filename << endl;
+                throw runtime_error("Erro no arquivo XML");
+            }
+            bloco_fluxo = TAMANHO_BLOCO_FLUXO;
+        }
     }
 
-    size_t indice = 0;
-    while (indice < ultimo_indice) {
-        Cenario c(texto, indice);
-        int area = CalcularAreaLimpeza(c.matriz, c.x, c.y, c.altura, c.largura);
-        cout << c.nome << " " << area << endl;
-        indice = c.indice_final;
+    // A saída fica guardada até o fim: se o XML estiver mal aninhado,
+    // apenas "erro" deve ser impresso.
+    string saida;
+    vector<Recursos> recursos;
+    bool valido;
+    if (bloco_fluxo > 0) {
+        if (!opcoes.converter.empty()) {
+            cerr << "--converter precisa de um arquivo, nao de um fluxo" << endl;
+            return 1;
+        }
+        LeitorFluxo leitor(fd, bloco_fluxo);
+        valido = ProcessaFluxo(leitor, opcoes, recursos, saida);
+        if (fd != 0) close(fd);
+        if (leitor.falhou()) {
+            cerr << "Erro ao ler a entrada " << filename << endl;
+            throw runtime_error("Erro no arquivo XML");
+        }
+    } else {
+        // Abertura do arquivo, mapeado em memória (sem cópia para uma string)
+        ArquivoMapeado filexml(filename);
+        if (!filexml.is_open()) {
+            cerr << "Erro ao abrir o arquivo " << filename << endl;
+            throw runtime_error("Erro no arquivo XML");
+        }
+        string_view texto = filexml.conteudo();
+
+        if (!opcoes.converter.empty()) {
+            if (EhCenb(texto)) {
+                cerr << filename << " ja esta no formato .cenb" << endl;
+                return 1;
+            }
+            return ConverteParaCenb(texto, opcoes.converter);
+        }
+
+        valido = ProcessaTexto(texto, opcoes, recursos, saida);
+    }
+    if (opcoes.cache != nullptr) {
+        // Só guarda as áreas de um XML válido
+        if (valido && !cache.grava()) cerr << "Erro ao gravar o cache" << endl;
+        cerr << "cache: " << cache.acertos() << " acertos, "
+             << cache.faltas() << " faltas" << endl;
+    }
+    if (!valido) {
+        cerr << "erro" << endl;
+        return 0;
     }
+    cout << saida;
 
     return 0;
 }
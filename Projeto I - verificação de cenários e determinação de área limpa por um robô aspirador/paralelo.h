@@ -0,0 +1,135 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <condition_variable>
+#include <cstddef>  // std::size_t
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>  // std::move
+#include <vector>
+
+#include "array_queue.h"  // fila circular com capacidade fixa
+
+//! CLASSE POOL DE TRABALHO
+//! Um conjunto fixo de threads que consome tarefas de uma fila limitada
+//! (ArrayQueue). Quando a fila enche, submete() espera, então quem produz
+//! as tarefas nunca fica muito à frente de quem as processa. A função de
+//! trabalho recebe o número da thread (0 .. trabalhadores - 1), para que
+//! cada uma use os seus próprios recursos sem precisar de trava.
+template<typename Tarefa>
+class PoolTrabalho {
+ public:
+    typedef std::function<void(std::size_t, Tarefa&)> Funcao;
+
+    //! construtor: inicia 'trabalhadores' threads
+    PoolTrabalho(std::size_t trabalhadores, std::size_t capacidade, Funcao funcao);
+    //! destrutor: espera as tarefas pendentes
+    ~PoolTrabalho();
+    PoolTrabalho(const PoolTrabalho&) = delete;
+    PoolTrabalho& operator=(const PoolTrabalho&) = delete;
+    //! metodo coloca uma tarefa na fila (espera se estiver cheia)
+    void submete(const Tarefa& tarefa);
+    //! metodo espera todas as tarefas terminarem e encerra as threads
+    void termina();
+
+ private:
+    void executa(std::size_t trabalhador);
+
+    structures::ArrayQueue<Tarefa> fila_;
+    std::mutex trava_;
+    std::condition_variable tem_tarefa_;
+    std::condition_variable tem_espaco_;
+    std::vector<std::thread> threads_;
+    Funcao funcao_;
+    bool encerrando_;
+};
+
+//! CLASSE BUFFER ORDENADO
+//! Buffer de reordenação: as threads entregam resultados fora de ordem,
+//! cada um com o seu número de sequência, e eles são lidos na ordem
+//! original.
+class BufferOrdenado {
+ public:
+    //! metodo guarda o resultado de número 'ordem'
+    void coloca(std::size_t ordem, std::string texto);
+    //! metodo anexa a 'saida' todos os resultados, em ordem
+    void escreve(std::string& saida);
+
+ private:
+    std::mutex trava_;
+    std::vector<std::string> resultados_;
+};
+
+// construtor
+template<typename Tarefa>
+PoolTrabalho<Tarefa>::PoolTrabalho(std::size_t trabalhadores,
+                                   std::size_t capacidade, Funcao funcao)
+    : fila_(capacidade), funcao_(std::move(funcao)) {
+    encerrando_ = false;
+    for (std::size_t i = 0; i < trabalhadores; i++) {
+        threads_.emplace_back(&PoolTrabalho::executa, this, i);
+    }
+}
+
+// destrutor
+template<typename Tarefa>
+PoolTrabalho<Tarefa>::~PoolTrabalho() {
+    termina();
+}
+
+// submete tarefa
+template<typename Tarefa>
+void PoolTrabalho<Tarefa>::submete(const Tarefa& tarefa) {
+    std::unique_lock<std::mutex> trava(trava_);
+    tem_espaco_.wait(trava, [this] { return !fila_.full(); });
+    fila_.enqueue(tarefa);
+    tem_tarefa_.notify_one();
+}
+
+// espera e encerra
+template<typename Tarefa>
+void PoolTrabalho<Tarefa>::termina() {
+    {
+        std::lock_guard<std::mutex> trava(trava_);
+        encerrando_ = true;
+    }
+    tem_tarefa_.notify_all();
+    for (std::thread& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+    threads_.clear();
+}
+
+// laço de cada thread
+template<typename Tarefa>
+void PoolTrabalho<Tarefa>::executa(std::size_t trabalhador) {
+    Tarefa tarefa;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> trava(trava_);
+            tem_tarefa_.wait(trava, [this] { return encerrando_ || !fila_.empty(); });
+            if (fila_.empty()) return;  // encerrando e sem tarefas
+            tarefa = fila_.dequeue();
+            tem_espaco_.notify_one();
+        }
+        funcao_(trabalhador, tarefa);
+    }
+}
+
+// guarda resultado
+inline void BufferOrdenado::coloca(std::size_t ordem, std::string texto) {
+    std::lock_guard<std::mutex> trava(trava_);
+    if (resultados_.size() <= ordem) resultados_.resize(ordem + 1);
+    resultados_[ordem] = std::move(texto);
+}
+
+// escreve em ordem
+inline void BufferOrdenado::escreve(std::string& saida) {
+    std::lock_guard<std::mutex> trava(trava_);
+    for (const std::string& texto : resultados_) saida += texto;
+}
+
+#endif
@@ -0,0 +1,559 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef PREENCHIMENTO_H
+#define PREENCHIMENTO_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t, std::int64_t
+#include <string_view>
+#include <vector>
+
+#include "grid.h"
+#include "grid_rle.h"
+#include "dilatacao_bits.h"
+#include "resumo_blocos.h"
+#include "rotulacao.h"
+#include "vizinhanca.h"  // políticas de vizinhança-4 e 8
+#include "telemetria.h"  // contadores opcionais (-DTELEMETRIA)
+
+//! Motores de cálculo da área alcançável pelo robô
+enum class Motor {
+    BFS,  // busca em largura, célula a célula
+    Varredura,  // preenchimento por faixas horizontais (scanline)
+    Bits,  // dilatação de palavras de bits até o ponto fixo
+    Rotulos,  // rotulação de todas as componentes conexas do mapa
+    Ladrilhos,  // rotulação em faixas paralelas, para um único mapa enorme
+    Trechos,  // união dos trechos livres de cada linha (mapa em RLE)
+    Blocos  // blocos de 64x64 resumidos; os todo livres entram de uma vez
+};
+
+//! Converte o nome de um motor ("bfs", "varredura", "bits", "rotulos",
+//! "ladrilhos", "trechos", "blocos"); retorna false se o nome não for
+//! conhecido
+bool motor_de_nome(std::string_view nome, Motor& motor);
+
+//! Memória de trabalho dos motores (visitadas, filas, rótulos), guardada
+//! por quem chama para ser reaproveitada de um mapa para o outro: depois
+//! do primeiro mapa grande, os seguintes não alocam mais nada.
+struct MemoriaPreenchimento {
+    Grid visitadas;
+    std::vector<std::uint32_t> fila;  // fronteira da BFS ou pilha de sementes
+    std::vector<std::uint32_t> proxima;  // próxima fronteira da BFS
+    std::vector<std::uint64_t> vazia;  // linha de zeros (AreaBits)
+    std::vector<std::uint64_t> livres;  // mapa com borda de sentinela (AreaBFS)
+                                        // ou estado das palavras (bateria.h)
+    Componentes componentes;
+    std::vector<FaixaRotulada> faixas;  // uma por thread (AreaLadrilhos)
+    UniaoBuscaConcorrente conjuntos;  // células de divisa (AreaLadrilhos)
+    GridRLE trechos;  // mapa em trechos (motor Trechos)
+    UniaoBusca uniao_trechos;  // um conjunto por trecho
+    ResumoBlocos blocos;  // estado de cada bloco 64x64 (AreaBlocos)
+    Grid sementes;  // células a visitar nos blocos da pilha (AreaBlocos)
+    std::vector<std::uint8_t> na_pilha;  // um por bloco (AreaBlocos)
+    TELEMETRIA_CONTA(EstatisticasPreenchimento estatisticas;)
+};
+
+//! Área alcançável por busca em largura (Vizinhanca4 ou Vizinhanca8)
+template <typename Vizinhanca>
+int AreaBFS(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria);
+
+//! Área alcançável por preenchimento de faixas (Vizinhanca4 ou Vizinhanca8)
+template <typename Vizinhanca>
+int AreaVarredura(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria);
+
+//! Área alcançável por dilatação de bits (vizinhança-4)
+int AreaBits(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria);
+
+//! Área da componente conexa do robô, rotulando o mapa inteiro
+int AreaRotulos(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria,
+                int conectividade = 4);
+
+//! Área alcançável unindo os trechos livres que se tocam em linhas vizinhas
+//! (Vizinhanca4 ou Vizinhanca8); o custo cresce com o número de trechos
+template <typename Vizinhanca>
+int AreaTrechos(const GridRLE& mapa, int x0, int y0, MemoriaPreenchimento& memoria);
+
+//! Área alcançável bloco a bloco sobre o resumo de blocos 64x64
+//! (Vizinhanca4 ou Vizinhanca8): um bloco todo livre é contado de uma vez
+template <typename Vizinhanca>
+int AreaBlocos(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria);
+
+//! AreaTrechos com a vizinhança escolhida em tempo de execução (4 ou 8)
+int CalcularAreaTrechos(const GridRLE& mapa, int x0, int y0,
+                        MemoriaPreenchimento& memoria, int conectividade = 4);
+
+//! Calcula a área limpa pelo robô na posição (x0, y0) com o motor escolhido.
+//! 'mapa' tem 1 nas células livres; x0 é a linha e y0 a coluna do robô.
+//! 'threads' só é usado pelo motor Ladrilhos. 'conectividade' é 4 ou 8;
+//! com 8, o motor Bits (só vizinhança-4) dá lugar ao Varredura. A área é
+//! de 64 bits: o motor Ladrilhos atende mapas com mais de 2^31 células.
+std::int64_t CalcularAreaLimpeza(const Grid& mapa, int x0, int y0,
+                        Motor motor = Motor::BFS, std::size_t threads = 1,
+                        int conectividade = 4);
+
+//! O mesmo, reaproveitando a memória de trabalho de 'memoria'
+std::int64_t CalcularAreaLimpeza(const Grid& mapa, int x0, int y0, Motor motor,
+                        std::size_t threads, MemoriaPreenchimento& memoria,
+                        int conectividade = 4);
+
+// nome do motor
+inline bool motor_de_nome(std::string_view nome, Motor& motor) {
+    if (nome == "bfs") {
+        motor = Motor::BFS;
+    } else if (nome == "varredura") {
+        motor = Motor::Varredura;
+    } else if (nome == "bits") {
+        motor = Motor::Bits;
+    } else if (nome == "rotulos") {
+        motor = Motor::Rotulos;
+    } else if (nome == "ladrilhos") {
+        motor = Motor::Ladrilhos;
+    } else if (nome == "trechos") {
+        motor = Motor::Trechos;
+    } else if (nome == "blocos") {
+        motor = Motor::Blocos;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Copia o mapa para 'livres', um vetor de bits linear de (altura + 2) x
+// (largura + 2) células cuja moldura fica ocupada (borda de sentinela).
+// Cada linha do Grid é deslocada para a sua posição, uma palavra por vez.
+// A última palavra de uma linha pode transbordar para a palavra seguinte
+// mesmo quando os bits dela acabam antes (ficam zero), então o vetor tem
+// uma palavra de folga depois da última célula.
+inline void CopiaComBorda(const Grid& mapa, std::vector<std::uint64_t>& livres) {
+    std::size_t largura_borda = mapa.largura() + 2;
+    std::size_t total = (mapa.altura() + 2) * largura_borda;
+    livres.assign(total / 64 + 2, 0);
+    for (std::size_t i = 0; i < mapa.altura(); i++) {
+        const std::uint64_t* linha = mapa.linha(i);
+        std::size_t inicio = (i + 1) * largura_borda + 1;
+        for (std::size_t k = 0; k < mapa.palavras_por_linha(); k++) {
+            std::uint64_t palavra = linha[k];
+            if (palavra == 0) continue;
+            std::size_t bit = inicio + 64 * k;
+            livres[bit / 64] |= palavra << (bit % 64);
+            if (bit % 64 != 0) livres[bit / 64 + 1] |= palavra >> (64 - bit % 64);
+        }
+    }
+}
+
+// Busca em largura por níveis sobre a cópia do mapa com borda de
+// sentinela: cada célula é desmarcada de 'livres' quando visitada, então o
+// teste de um vizinho é um único acesso a bit, sem verificar limites e sem
+// um grid separado de visitadas. Cada célula é um índice linear de 32 bits
+// no mapa com borda e só os dois níveis em uso da fronteira ficam
+// guardados. O laço dos vizinhos é desenrolado para a Vizinhanca dada.
+template <typename Vizinhanca>
+inline int AreaBFS(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria) {
+    const std::int64_t largura_borda = static_cast<std::int64_t>(mapa.largura()) + 2;
+    std::vector<std::uint64_t>& livres = memoria.livres;
+    CopiaComBorda(mapa, livres);
+
+    // Fronteira atual e próxima fronteira, trocadas a cada nível
+    std::vector<std::uint32_t>& fronteira = memoria.fila;
+    std::vector<std::uint32_t>& proxima = memoria.proxima;
+    fronteira.clear();
+    proxima.clear();
+    std::uint32_t inicio = static_cast<std::uint32_t>((x0 + 1) * largura_borda + y0 + 1);
+    livres[inicio / 64] &= ~(std::uint64_t(1) << (inicio % 64));
+    fronteira.push_back(inicio);
+    int area = 1;
+
+    while (!fronteira.empty()) {
+        TELEMETRIA_CONTA(memoria.estatisticas.fila(fronteira.size());)
+        for (std::uint32_t indice : fronteira) {
+            ParaCadaVizinho<Vizinhanca>([&](int dx, int dy) {
+                std::uint32_t vizinho = static_cast<std::uint32_t>(
+                    indice + dx * largura_borda + dy);
+                std::uint64_t bit = std::uint64_t(1) << (vizinho % 64);
+                std::uint64_t& palavra = livres[vizinho / 64];
+                if (palavra & bit) {
+                    palavra &= ~bit;  // Marca como visitado
+                    proxima.push_back(vizinho);
+                    area++;
+                }
+            });
+        }
+        fronteira.swap(proxima);
+        proxima.clear();
+    }
+
+    TELEMETRIA_CONTA(memoria.estatisticas.visitadas = area;)
+    return area;
+}
+
+// Primeira coluna em [c, fim) cuja célula está (disponivel == true) ou não
+// está (disponivel == false) livre e ainda não visitada; 'fim' se não houver.
+// Percorre uma palavra de 64 colunas por vez.
+inline std::size_t ProcuraColuna(const std::uint64_t* mapa,
+                                 const std::uint64_t* visitadas,
+                                 std::size_t c, std::size_t fim,
+                                 bool disponivel) {
+    while (c < fim) {
+        std::size_t w = c / 64;
+        std::uint64_t palavra = mapa[w] & ~visitadas[w];
+        if (!disponivel) palavra = ~palavra;
+        palavra &= ~std::uint64_t(0) << (c % 64);
+        if (palavra != 0) {
+            std::size_t coluna = w * 64 + __builtin_ctzll(palavra);
+            return coluna < fim ? coluna : fim;
+        }
+        c = (w + 1) * 64;
+    }
+    return fim;
+}
+
+// Menor coluna l <= c tal que todas as células de [l, c] estão livres e
+// não visitadas (a célula c precisa estar)
+inline std::size_t InicioDaFaixa(const std::uint64_t* mapa,
+                                 const std::uint64_t* visitadas,
+                                 std::size_t c) {
+    std::size_t w = c / 64;
+    std::size_t b = c % 64;
+    std::uint64_t bloqueadas = ~(mapa[w] & ~visitadas[w]);
+    if (b < 63) bloqueadas &= (std::uint64_t(1) << (b + 1)) - 1;
+    while (bloqueadas == 0) {
+        if (w == 0) return 0;
+        w--;
+        bloqueadas = ~(mapa[w] & ~visitadas[w]);
+    }
+    return w * 64 + (63 - __builtin_clzll(bloqueadas)) + 1;
+}
+
+// Preenchimento por faixas: cada semente é estendida até a faixa horizontal
+// inteira de células livres, que é marcada de uma vez. Nas linhas de cima e
+// de baixo, só a primeira célula de cada trecho livre sob a faixa vira uma
+// nova semente, então a pilha recebe uma entrada por faixa e não por célula.
+// Na vizinhança-8, os trechos vizinhos são procurados uma coluna além de
+// cada ponta da faixa (as diagonais).
+template <typename Vizinhanca>
+inline int AreaVarredura(const Grid& mapa, int x0, int y0,
+                         MemoriaPreenchimento& memoria) {
+    std::size_t altura = mapa.altura();
+    std::size_t largura = mapa.largura();
+
+    // Grid R para controlar os pontos visitados
+    Grid& R = memoria.visitadas;
+    R.redimensiona(altura, largura);
+
+    std::vector<std::uint32_t>& sementes = memoria.fila;
+    sementes.clear();
+    sementes.push_back(static_cast<std::uint32_t>(x0) * largura + y0);
+    int area = 0;
+
+    while (!sementes.empty()) {
+        std::uint32_t indice = sementes.back();
+        sementes.pop_back();
+        std::size_t x = indice / largura;
+        std::size_t y = indice % largura;
+
+        const std::uint64_t* linha_mapa = mapa.linha(x);
+        const std::uint64_t* linha_R = R.linha(x);
+        // Outra faixa pode já ter coberto esta semente
+        if (ProcuraColuna(linha_mapa, linha_R, y, y + 1, true) != y) continue;
+
+        std::size_t inicio = InicioDaFaixa(linha_mapa, linha_R, y);
+        std::size_t fim = ProcuraColuna(linha_mapa, linha_R, y, largura, false);
+        R.set_intervalo(x, inicio, fim);
+        area += static_cast<int>(fim - inicio);
+        TELEMETRIA_CONTA(memoria.estatisticas.visitadas += fim - inicio;)
+
+        // Uma semente por trecho livre nas linhas vizinhas, sob [de, ate)
+        std::size_t de = inicio, ate = fim;
+        if constexpr (Vizinhanca::diagonais) {
+            if (de > 0) de--;
+            if (ate < largura) ate++;
+        }
+        for (int d = -1; d <= 1; d += 2) {
+            if ((d < 0 && x == 0) || (d > 0 && x + 1 >= altura)) continue;
+            std::size_t nx = x + d;
+            const std::uint64_t* vizinha_mapa = mapa.linha(nx);
+            const std::uint64_t* vizinha_R = R.linha(nx);
+            std::size_t c = de;
+            while (c < ate) {
+                c = ProcuraColuna(vizinha_mapa, vizinha_R, c, ate, true);
+                if (c >= ate) break;
+                sementes.push_back(static_cast<std::uint32_t>(nx * largura + c));
+                c = ProcuraColuna(vizinha_mapa, vizinha_R, c, ate, false);
+            }
+        }
+        TELEMETRIA_CONTA(memoria.estatisticas.fila(sementes.size());)
+    }
+
+    return area;
+}
+
+// Dilatação de bits: o conjunto alcançado R cresce linha a linha com
+// (R | vizinhos horizontais | linha de cima | linha de baixo) & livres,
+// 64 células por operação (256 com AVX2), até nenhuma linha mudar. As
+// linhas são varridas de cima para baixo e de baixo para cima, sobre o
+// próprio R, para que cada passada leve o alcance até o outro lado do mapa.
+// Indicado para salas grandes e abertas; em labirintos o número de
+// passadas cresce com as voltas do caminho.
+inline int AreaBits(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria) {
+    std::size_t altura = mapa.altura();
+    std::size_t n = mapa.palavras_por_linha();
+
+    Grid& R = memoria.visitadas;
+    R.redimensiona(altura, mapa.largura());
+    R.set(x0, y0);
+    std::vector<std::uint64_t>& vazia = memoria.vazia;
+    vazia.assign(n, 0);  // vizinha fora do mapa
+    NucleoDilatacao atualiza = EscolheNucleoDilatacao();
+
+    auto atualiza_linha = [&](std::size_t i) {
+        const std::uint64_t* cima = i > 0 ? R.linha(i - 1) : vazia.data();
+        const std::uint64_t* baixo = i + 1 < altura ? R.linha(i + 1) : vazia.data();
+        return atualiza(R.linha(i), cima, baixo, mapa.linha(i), n);
+    };
+
+    bool mudou = true;
+    while (mudou) {
+        TELEMETRIA_CONTA(memoria.estatisticas.passadas++;)
+        TELEMETRIA_CONTA(memoria.estatisticas.visitadas += 2 * altura * mapa.largura();)
+        mudou = false;
+        for (std::size_t i = 0; i < altura; i++) mudou |= atualiza_linha(i);
+        for (std::size_t i = altura; i-- > 0; ) mudou |= atualiza_linha(i);
+    }
+
+    return static_cast<int>(ContaBits(R.linha(0), altura * n));
+}
+
+// Rotulação: custa O(células) uma vez; compensa quando o mesmo mapa
+// responde a várias posições (ver Componentes em rotulacao.h)
+inline int AreaRotulos(const Grid& mapa, int x0, int y0,
+                       MemoriaPreenchimento& memoria, int conectividade) {
+    memoria.componentes.rotula(mapa, conectividade);
+    TELEMETRIA_CONTA(memoria.estatisticas.visitadas = mapa.altura() * mapa.largura();)
+    return memoria.componentes.area(x0, y0);
+}
+
+// Trechos: cada trecho livre de uma linha é um elemento da união-busca.
+// Os trechos de duas linhas vizinhas estão ordenados por coluna, então uma
+// única passada com dois índices (como na intercalação do merge sort) une
+// todos os pares que se sobrepõem; na vizinhança-8, encostar pela ponta
+// (diagonal) também conta. A área é a soma dos comprimentos dos trechos
+// que ficaram no conjunto do trecho do robô.
+template <typename Vizinhanca>
+inline int AreaTrechos(const GridRLE& mapa, int x0, int y0,
+                       MemoriaPreenchimento& memoria) {
+    if (x0 < 0 || y0 < 0) return 0;
+    std::ptrdiff_t trecho_robo = mapa.procura(x0, y0);
+    if (trecho_robo < 0) return 0;
+
+    const std::vector<TrechoLivre>& trechos = mapa.trechos();
+    UniaoBusca& conjuntos = memoria.uniao_trechos;
+    conjuntos.clear();
+    for (std::size_t k = 0; k < trechos.size(); k++) conjuntos.cria();
+
+    const std::uint32_t folga = Vizinhanca::diagonais ? 1 : 0;
+    for (std::size_t i = 1; i < mapa.altura(); i++) {
+        std::size_t a = mapa.primeiro(i - 1), fim_a = mapa.primeiro(i);
+        std::size_t b = fim_a, fim_b = mapa.primeiro(i + 1);
+        while (a < fim_a && b < fim_b) {
+            if (trechos[a].inicio < trechos[b].fim + folga &&
+                trechos[b].inicio < trechos[a].fim + folga) {
+                conjuntos.une(static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b));
+            }
+            // Avança o trecho que termina antes: ele não toca mais ninguém
+            if (trechos[a].fim < trechos[b].fim) {
+                a++;
+            } else {
+                b++;
+            }
+        }
+    }
+
+    std::uint32_t raiz = conjuntos.busca(static_cast<std::uint32_t>(trecho_robo));
+    int area = 0;
+    for (std::size_t k = 0; k < trechos.size(); k++) {
+        if (conjuntos.busca(static_cast<std::uint32_t>(k)) == raiz) {
+            area += static_cast<int>(trechos[k].fim - trechos[k].inicio);
+        }
+    }
+    TELEMETRIA_CONTA(memoria.estatisticas.visitadas = trechos.size();)
+    return area;
+}
+
+// Blocos: o mapa é percorrido bloco a bloco (resumo_blocos.h), com uma
+// pilha dos blocos que receberam sementes, isto é, células livres ainda
+// não alcançadas vizinhas de células alcançadas (guardadas em 'sementes').
+// Um bloco todo livre é conexo, então qualquer semente o preenche inteiro
+// em um passo; um bloco misto é preenchido por dilatação de bits só nas
+// suas 64 palavras, como em AreaBits, e blocos ocupados nunca entram na
+// pilha. As células alcançadas de novo na borda do bloco semeiam os
+// blocos vizinhos. Em mapas quase vazios o custo fica perto de um passo
+// por bloco; em labirintos todos os blocos são mistos e o BFS é melhor.
+template <typename Vizinhanca>
+inline int AreaBlocos(const Grid& mapa, int x0, int y0, MemoriaPreenchimento& memoria) {
+    const std::size_t altura = mapa.altura(), largura = mapa.largura();
+    const std::size_t n = mapa.palavras_por_linha();
+    ResumoBlocos& resumo = memoria.blocos;
+    resumo.resume(mapa);
+    Grid& R = memoria.visitadas;
+    Grid& sementes = memoria.sementes;
+    R.redimensiona(altura, largura);
+    sementes.redimensiona(altura, largura);
+    std::vector<std::uint32_t>& pilha = memoria.fila;
+    std::vector<std::uint8_t>& na_pilha = memoria.na_pilha;
+    pilha.clear();
+    na_pilha.assign(resumo.blocos_altura() * n, 0);
+
+    // Semeia as colunas 'bits' da palavra k da linha i que estiverem
+    // livres e ainda não alcançadas, empilhando o bloco delas
+    auto semeia = [&](std::size_t i, std::size_t k, std::uint64_t bits) {
+        bits &= mapa.linha(i)[k] & ~R.linha(i)[k];
+        if (bits == 0) return;
+        sementes.linha(i)[k] |= bits;
+        std::uint32_t bloco = static_cast<std::uint32_t>(i / LADO_BLOCO * n + k);
+        if (!na_pilha[bloco]) {
+            na_pilha[bloco] = 1;
+            pilha.push_back(bloco);
+        }
+    };
+    // Colunas alcançáveis na linha de cima ou de baixo a partir de 'v'
+    auto vertical = [](std::uint64_t v) {
+        return Vizinhanca::diagonais ? v | v << 1 | v >> 1 : v;
+    };
+
+    std::uint64_t alcancadas[LADO_BLOCO];  // por linha do bloco
+    std::uint64_t novas[LADO_BLOCO];  // alcançadas nesta visita ao bloco
+    semeia(x0, y0 / 64, std::uint64_t(1) << (y0 % 64));
+    int area = 0;
+
+    while (!pilha.empty()) {
+        TELEMETRIA_CONTA(memoria.estatisticas.fila(pilha.size());)
+        std::uint32_t bloco = pilha.back();
+        pilha.pop_back();
+        na_pilha[bloco] = 0;
+        std::size_t k = bloco % n;
+        std::size_t inicio = bloco / n * LADO_BLOCO;
+        std::size_t fim = inicio + LADO_BLOCO < altura ? inicio + LADO_BLOCO : altura;
+        std::size_t linhas = fim - inicio;
+        TELEMETRIA_CONTA(memoria.estatisticas.visitadas += linhas * 64;)
+
+        if (resumo.estado(bloco / n, k) == EstadoBloco::Livre) {
+            // Todo livre: a semente alcança o bloco inteiro
+            std::uint64_t mascara = MascaraPalavra(largura, k);
+            for (std::size_t r = 0; r < linhas; r++) {
+                std::uint64_t& visitadas = R.linha(inicio + r)[k];
+                novas[r] = mascara & ~visitadas;
+                visitadas = mascara;
+                sementes.linha(inicio + r)[k] = 0;
+            }
+        } else {
+            for (std::size_t r = 0; r < linhas; r++) {
+                std::uint64_t& semente = sementes.linha(inicio + r)[k];
+                alcancadas[r] = R.linha(inicio + r)[k] | semente;
+                semente = 0;
+            }
+            auto dilata = [&](std::size_t r) {
+                std::uint64_t livre = mapa.linha(inicio + r)[k];
+                std::uint64_t g = alcancadas[r];
+                if (r > 0) g |= vertical(alcancadas[r - 1]);
+                if (r + 1 < linhas) g |= vertical(alcancadas[r + 1]);
+                g &= livre;
+                g = EspalhaDireita(g, livre) | EspalhaEsquerda(g, livre);
+                bool mudou = g != alcancadas[r];
+                alcancadas[r] = g;
+                return mudou;
+            };
+            bool mudou = true;
+            while (mudou) {
+                TELEMETRIA_CONTA(memoria.estatisticas.passadas++;)
+                mudou = false;
+                for (std::size_t r = 0; r < linhas; r++) mudou |= dilata(r);
+                for (std::size_t r = linhas; r-- > 0; ) mudou |= dilata(r);
+            }
+            for (std::size_t r = 0; r < linhas; r++) {
+                std::uint64_t& visitadas = R.linha(inicio + r)[k];
+                novas[r] = alcancadas[r] & ~visitadas;
+                visitadas = alcancadas[r];
+            }
+        }
+
+        // As células novas da borda semeiam os blocos vizinhos (na
+        // vizinhança-8, as colunas da ponta também semeiam as linhas de
+        // cima e de baixo do bloco ao lado)
+        if (inicio > 0) semeia(inicio - 1, k, vertical(novas[0]));
+        if (fim < altura) semeia(fim, k, vertical(novas[linhas - 1]));
+        for (std::size_t r = 0; r < linhas; r++) {
+            area += __builtin_popcountll(novas[r]);
+            std::size_t i = inicio + r;
+            std::size_t primeira = Vizinhanca::diagonais && i > 0 ? i - 1 : i;
+            std::size_t ultima = Vizinhanca::diagonais && i + 1 < altura ? i + 1 : i;
+            for (std::size_t j = primeira; j <= ultima; j++) {
+                if (k > 0 && (novas[r] & 1u)) semeia(j, k - 1, std::uint64_t(1) << 63);
+                if (k + 1 < n && (novas[r] >> 63)) semeia(j, k + 1, 1u);
+            }
+        }
+    }
+
+    return area;
+}
+
+// escolhe a vizinhança dos trechos
+inline int CalcularAreaTrechos(const GridRLE& mapa, int x0, int y0,
+                               MemoriaPreenchimento& memoria, int conectividade) {
+    TELEMETRIA_CONTA(memoria.estatisticas.zera();)
+    if (conectividade == 8) return AreaTrechos<Vizinhanca8>(mapa, x0, y0, memoria);
+    return AreaTrechos<Vizinhanca4>(mapa, x0, y0, memoria);
+}
+
+// escolhe o motor, com memória de trabalho própria
+inline std::int64_t CalcularAreaLimpeza(const Grid& mapa, int x0, int y0, Motor motor,
+                                        std::size_t threads, int conectividade) {
+    MemoriaPreenchimento memoria;
+    return CalcularAreaLimpeza(mapa, x0, y0, motor, threads, memoria, conectividade);
+}
+
+// escolhe o motor
+inline std::int64_t CalcularAreaLimpeza(const Grid& mapa, int x0, int y0, Motor motor,
+                                        std::size_t threads, MemoriaPreenchimento& memoria,
+                                        int conectividade) {
+    int altura = static_cast<int>(mapa.altura());
+    int largura = static_cast<int>(mapa.largura());
+    TELEMETRIA_CONTA(memoria.estatisticas.zera();)
+
+    // O cenário pode chegar aqui antes do fim da verificação do XML,
+    // então a posição do robô é conferida antes de qualquer acesso
+    if (x0 < 0 || x0 >= altura || y0 < 0 || y0 >= largura) return 0;
+
+    if (!mapa.get(x0, y0)) return 0;
+
+    if (motor == Motor::Trechos) {
+        memoria.trechos.de_grid(mapa);
+        return CalcularAreaTrechos(memoria.trechos, x0, y0, memoria, conectividade);
+    }
+
+    if (conectividade == 8) {
+        switch (motor) {
+            case Motor::Rotulos: return AreaRotulos(mapa, x0, y0, memoria, 8);
+            case Motor::BFS: return AreaBFS<Vizinhanca8>(mapa, x0, y0, memoria);
+            case Motor::Blocos: return AreaBlocos<Vizinhanca8>(mapa, x0, y0, memoria);
+            case Motor::Ladrilhos:
+                TELEMETRIA_CONTA(memoria.estatisticas.visitadas = mapa.altura() * mapa.largura();)
+                return AreaLadrilhos<Vizinhanca8>(mapa, x0, y0, threads, memoria.faixas,
+                                                  memoria.conjuntos);
+            default: return AreaVarredura<Vizinhanca8>(mapa, x0, y0, memoria);
+        }
+    }
+
+    switch (motor) {
+        case Motor::Varredura: return AreaVarredura<Vizinhanca4>(mapa, x0, y0, memoria);
+        case Motor::Bits: return AreaBits(mapa, x0, y0, memoria);
+        case Motor::Rotulos: return AreaRotulos(mapa, x0, y0, memoria);
+        case Motor::Blocos: return AreaBlocos<Vizinhanca4>(mapa, x0, y0, memoria);
+        case Motor::Ladrilhos:
+            TELEMETRIA_CONTA(memoria.estatisticas.visitadas = mapa.altura() * mapa.largura();)
+            return AreaLadrilhos<Vizinhanca4>(mapa, x0, y0, threads, memoria.faixas,
+                                              memoria.conjuntos);
+        case Motor::BFS:
+        default: return AreaBFS<Vizinhanca4>(mapa, x0, y0, memoria);
+    }
+}
+
+#endif
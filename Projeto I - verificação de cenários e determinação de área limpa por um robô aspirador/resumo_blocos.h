@@ -0,0 +1,118 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef RESUMO_BLOCOS_H
+#define RESUMO_BLOCOS_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint64_t
+#include <vector>
+
+#include "grid.h"
+
+//! Lado dos blocos do resumo: 64 linhas por uma palavra de 64 colunas
+constexpr std::size_t LADO_BLOCO = 64;
+
+//! Estado de um bloco do resumo
+enum class EstadoBloco : std::uint8_t {
+    Ocupado,  // nenhuma célula livre
+    Livre,  // todas as células livres
+    Misto
+};
+
+//! CLASSE RESUMO BLOCOS
+//! Segundo nível sobre um Grid: o mapa é dividido em blocos de 64 linhas
+//! por uma palavra de 64 colunas e cada bloco guarda só se é todo livre,
+//! todo ocupado ou misto. Os blocos da última linha e da última coluna
+//! podem ser menores; só contam as células dentro do mapa.
+class ResumoBlocos {
+ public:
+    //! construtor padrao (resumo vazio)
+    ResumoBlocos();
+    //! metodo resume um Grid, com um E e um OU por palavra de 64 células
+    void resume(const Grid& mapa);
+    //! metodo retorna o estado do bloco (bi, bj)
+    EstadoBloco estado(std::size_t bi, std::size_t bj) const;
+    //! metodo retorna a quantidade de linhas de blocos
+    std::size_t blocos_altura() const;
+    //! metodo retorna a quantidade de colunas de blocos
+    std::size_t blocos_largura() const;
+    //! metodo retorna quantos blocos estão no estado dado
+    std::size_t conta(EstadoBloco estado) const;
+
+ private:
+    std::vector<EstadoBloco> estados_;
+    std::vector<std::uint64_t> e_;  // E das palavras da faixa atual
+    std::vector<std::uint64_t> ou_;  // OU das palavras da faixa atual
+    std::size_t blocos_altura_;
+    std::size_t blocos_largura_;
+};
+
+//! Máscara das colunas dentro do mapa na palavra k de uma linha
+inline std::uint64_t MascaraPalavra(std::size_t largura, std::size_t k) {
+    std::size_t resto = largura - 64 * k;
+    return resto >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << resto) - 1;
+}
+
+// construtor padrao
+inline ResumoBlocos::ResumoBlocos() {
+    blocos_altura_ = 0;
+    blocos_largura_ = 0;
+}
+
+// resume o mapa
+// As linhas são lidas em ordem, acumulando o E e o OU de cada palavra da
+// faixa de 64 linhas; como os bits além da largura são sempre zero, o
+// bloco é todo livre quando o E é igual à máscara da palavra.
+inline void ResumoBlocos::resume(const Grid& mapa) {
+    std::size_t altura = mapa.altura();
+    std::size_t n = mapa.palavras_por_linha();
+    blocos_altura_ = (altura + LADO_BLOCO - 1) / LADO_BLOCO;
+    blocos_largura_ = n;
+    estados_.resize(blocos_altura_ * blocos_largura_);
+
+    for (std::size_t bi = 0; bi < blocos_altura_; bi++) {
+        e_.assign(n, ~std::uint64_t(0));
+        ou_.assign(n, 0);
+        std::size_t fim = (bi + 1) * LADO_BLOCO < altura ? (bi + 1) * LADO_BLOCO : altura;
+        for (std::size_t i = bi * LADO_BLOCO; i < fim; i++) {
+            const std::uint64_t* linha = mapa.linha(i);
+            for (std::size_t k = 0; k < n; k++) {
+                e_[k] &= linha[k];
+                ou_[k] |= linha[k];
+            }
+        }
+        for (std::size_t k = 0; k < n; k++) {
+            EstadoBloco& estado = estados_[bi * n + k];
+            if (ou_[k] == 0) {
+                estado = EstadoBloco::Ocupado;
+            } else if (e_[k] == MascaraPalavra(mapa.largura(), k)) {
+                estado = EstadoBloco::Livre;
+            } else {
+                estado = EstadoBloco::Misto;
+            }
+        }
+    }
+}
+
+// estado do bloco
+inline EstadoBloco ResumoBlocos::estado(std::size_t bi, std::size_t bj) const {
+    return estados_[bi * blocos_largura_ + bj];
+}
+
+// linhas de blocos
+inline std::size_t ResumoBlocos::blocos_altura() const {
+    return blocos_altura_;
+}
+
+// colunas de blocos
+inline std::size_t ResumoBlocos::blocos_largura() const {
+    return blocos_largura_;
+}
+
+// blocos no estado dado
+inline std::size_t ResumoBlocos::conta(EstadoBloco estado) const {
+    std::size_t total = 0;
+    for (EstadoBloco e : estados_) total += e == estado;
+    return total;
+}
+
+#endif
@@ -0,0 +1,304 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef ROTULACAO_H
+#define ROTULACAO_H
+
+#include <algorithm>  // std::min
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t, std::uint64_t, std::int64_t
+#include <thread>
+#include <vector>
+
+#include "grid.h"
+#include "uniao_busca.h"
+#include "vizinhanca.h"
+
+//! CLASSE COMPONENTES
+//! Rotulação das componentes conexas (vizinhança-4 ou 8) das células
+//! livres de um mapa. Depois de rotula(), a área alcançável a partir de qualquer
+//! posição é respondida em O(1): basta ler o rótulo da célula e o tamanho
+//! da componente.
+class Componentes {
+ public:
+    //! construtor padrao
+    Componentes();
+    //! metodo rotula todas as células livres de 'mapa' (O(células)), com
+    //! vizinhança-4 ou 8 ('conectividade')
+    void rotula(const Grid& mapa, int conectividade = 4);
+    //! metodo retorna o rótulo da célula (0 se ocupada ou fora do mapa)
+    std::uint32_t rotulo(int x, int y) const;
+    //! metodo retorna a área da componente da célula (0 se ocupada)
+    int area(int x, int y) const;
+    //! metodo retorna a área da componente de rótulo 'r'
+    int area_rotulo(std::uint32_t r) const;
+    //! metodo retorna a quantidade de componentes
+    std::size_t quantidade() const;
+
+ private:
+    template <typename Vizinhanca>
+    void primeira_passada(const Grid& mapa);
+
+    std::vector<std::uint32_t> rotulos_;  // um por célula; 0 = ocupada
+    std::vector<std::uint32_t> tamanhos_;  // tamanho de cada rótulo
+    UniaoBusca equivalencias_;  // rótulos provisórios da primeira passada
+    std::size_t altura_;
+    std::size_t largura_;
+};
+
+//! Primeira passada da rotulação em uma linha: cada célula livre de
+//! 'linha' recebe em 'atual' o rótulo provisório da vizinha de cima
+//! ('cima', nullptr na primeira linha) ou da esquerda, ou um rótulo novo
+//! de 'equivalencias'; rótulos vizinhos diferentes são unidos. As células
+//! ocupadas de 'atual' precisam chegar com 0.
+template <typename Vizinhanca>
+void RotulaLinha(const std::uint64_t* linha, std::size_t largura,
+                 const std::uint32_t* cima, std::uint32_t* atual,
+                 UniaoBusca& equivalencias);
+
+// construtor padrao
+inline Componentes::Componentes() {
+    altura_ = 0;
+    largura_ = 0;
+}
+
+// Rotulação em duas passadas pela ordem das linhas:
+// 1. cada célula livre recebe o rótulo da vizinha de cima ou da esquerda
+//    (ou um rótulo novo); quando as duas têm rótulos diferentes, eles são
+//    unidos na união-busca (na vizinhança-8, também as duas diagonais de
+//    cima);
+// 2. cada rótulo provisório é trocado pela raiz do seu conjunto, numerada
+//    de 1 em diante, e os tamanhos das componentes são contados.
+inline void Componentes::rotula(const Grid& mapa, int conectividade) {
+    altura_ = mapa.altura();
+    largura_ = mapa.largura();
+    rotulos_.assign(altura_ * largura_, 0);
+    equivalencias_.clear();
+    equivalencias_.cria();  // rótulo 0 reservado para as células ocupadas
+
+    if (conectividade == 8) {
+        primeira_passada<Vizinhanca8>(mapa);
+    } else {
+        primeira_passada<Vizinhanca4>(mapa);
+    }
+
+    // Segunda passada
+    std::vector<std::uint32_t> definitivo(equivalencias_.size(), 0);
+    tamanhos_.assign(1, 0);
+    for (std::size_t k = 0; k < rotulos_.size(); k++) {
+        std::uint32_t r = rotulos_[k];
+        if (r == 0) continue;
+        std::uint32_t raiz = equivalencias_.busca(r);
+        if (definitivo[raiz] == 0) {
+            definitivo[raiz] = static_cast<std::uint32_t>(tamanhos_.size());
+            tamanhos_.push_back(0);
+        }
+        rotulos_[k] = definitivo[raiz];
+        tamanhos_[definitivo[raiz]]++;
+    }
+}
+
+// Primeira passada: rótulos provisórios e equivalências
+template <typename Vizinhanca>
+void Componentes::primeira_passada(const Grid& mapa) {
+    for (std::size_t i = 0; i < altura_; i++) {
+        std::uint32_t* atual = rotulos_.data() + i * largura_;
+        const std::uint32_t* cima = i > 0 ? atual - largura_ : nullptr;
+        RotulaLinha<Vizinhanca>(mapa.linha(i), largura_, cima, atual, equivalencias_);
+    }
+}
+
+// primeira passada de uma linha
+template <typename Vizinhanca>
+void RotulaLinha(const std::uint64_t* linha, std::size_t largura,
+                 const std::uint32_t* cima, std::uint32_t* atual,
+                 UniaoBusca& equivalencias) {
+    for (std::size_t j = 0; j < largura; j++) {
+        if (!((linha[j / 64] >> (j % 64)) & 1u)) continue;
+        std::uint32_t r_cima = cima ? cima[j] : 0;
+        std::uint32_t r_esquerda = j > 0 ? atual[j - 1] : 0;
+        if (r_cima == 0 && r_esquerda == 0) {
+            atual[j] = equivalencias.cria();
+        } else if (r_cima == 0 || r_esquerda == 0) {
+            atual[j] = r_cima | r_esquerda;
+        } else {
+            if (r_cima != r_esquerda) equivalencias.une(r_cima, r_esquerda);
+            atual[j] = r_esquerda;
+        }
+        if constexpr (Vizinhanca::diagonais) {
+            if (cima == nullptr) continue;
+            if (j > 0 && cima[j - 1] != 0 && cima[j - 1] != atual[j]) {
+                equivalencias.une(atual[j], cima[j - 1]);
+            }
+            if (j + 1 < largura && cima[j + 1] != 0 && cima[j + 1] != atual[j]) {
+                equivalencias.une(atual[j], cima[j + 1]);
+            }
+        }
+    }
+}
+
+// rótulo da célula
+inline std::uint32_t Componentes::rotulo(int x, int y) const {
+    if (x < 0 || y < 0 || static_cast<std::size_t>(x) >= altura_ ||
+        static_cast<std::size_t>(y) >= largura_) {
+        return 0;
+    }
+    return rotulos_[static_cast<std::size_t>(x) * largura_ + y];
+}
+
+// área da componente da célula
+inline int Componentes::area(int x, int y) const {
+    return area_rotulo(rotulo(x, y));
+}
+
+// área de um rótulo
+inline int Componentes::area_rotulo(std::uint32_t r) const {
+    return static_cast<int>(tamanhos_[r]);
+}
+
+// quantidade de componentes
+inline std::size_t Componentes::quantidade() const {
+    return tamanhos_.size() - 1;
+}
+
+//! Rotulação de uma faixa de linhas do motor Ladrilhos: só a linha anterior
+//! fica guardada, e da faixa restam os rótulos (já trocados pelas raízes)
+//! da primeira e da última linha e a quantidade de células de cada raiz.
+struct FaixaRotulada {
+    UniaoBusca equivalencias;  // rótulos provisórios da faixa
+    std::vector<std::uint64_t> celulas;  // células de cada rótulo (depois, de cada raiz)
+    std::vector<std::uint32_t> primeira;  // rótulos da primeira linha
+    std::vector<std::uint32_t> ultima;  // rótulos da última linha
+    std::vector<std::uint32_t> anterior;  // linha de cima durante a rotulação
+    std::vector<std::uint32_t> representante;  // elemento de divisa de cada raiz
+    std::uint32_t robo = 0;  // rótulo do robô, se ele estiver na faixa
+};
+
+//! Área da componente de (x0, y0) rotulando o mapa em faixas paralelas
+//! (Vizinhanca4 ou Vizinhanca8). O mapa é dividido em 'threads' faixas de
+//! linhas inteiras (ladrilhos da largura do mapa); cada thread rotula a
+//! sua faixa linha a linha (RotulaLinha, a mesma passada de Componentes),
+//! e só as células da primeira e da última linha de cada faixa entram na
+//! UniaoBuscaConcorrente 'divisas', que junta as componentes de faixas
+//! vizinhas. A memória é a de um rótulo provisório por componente de
+//! faixa mais duas linhas por faixa, e não um elemento por célula.
+template <typename Vizinhanca>
+std::int64_t AreaLadrilhos(const Grid& mapa, int x0, int y0, std::size_t threads,
+                           std::vector<FaixaRotulada>& faixas,
+                           UniaoBuscaConcorrente& divisas) {
+    constexpr std::uint32_t SEM_DIVISA = ~std::uint32_t(0);
+    std::size_t altura = mapa.altura();
+    std::size_t largura = mapa.largura();
+    std::size_t quantidade = std::max<std::size_t>(1, std::min(threads, altura));
+    if (faixas.size() < quantidade) faixas.resize(quantidade);
+    divisas.redimensiona(2 * quantidade * largura);
+
+    auto inicio_faixa = [altura, quantidade](std::size_t k) {
+        return altura * k / quantidade;
+    };
+    // elemento de divisa da coluna j na primeira (lado 0) ou última (lado 1)
+    // linha da faixa k
+    auto elemento = [largura](std::size_t k, std::size_t lado, std::size_t j) {
+        return static_cast<std::uint32_t>((2 * k + lado) * largura + j);
+    };
+    auto em_paralelo = [quantidade](auto tarefa) {
+        std::vector<std::thread> grupo;
+        for (std::size_t k = 1; k < quantidade; k++) grupo.emplace_back(tarefa, k);
+        tarefa(0);
+        for (std::thread& t : grupo) t.join();
+    };
+
+    // 1. Cada faixa é rotulada localmente; os rótulos provisórios são
+    //    trocados pelas raízes e as células somadas em cada raiz
+    em_paralelo([&](std::size_t k) {
+        FaixaRotulada& f = faixas[k];
+        std::size_t r0 = inicio_faixa(k), r1 = inicio_faixa(k + 1);
+        f.equivalencias.clear();
+        f.equivalencias.cria();  // rótulo 0 reservado para as células ocupadas
+        f.celulas.assign(1, 0);
+        f.anterior.assign(largura, 0);
+        f.ultima.assign(largura, 0);
+        f.robo = 0;
+        for (std::size_t i = r0; i < r1; i++) {
+            if (i > r0) {
+                f.anterior.swap(f.ultima);
+                std::fill(f.ultima.begin(), f.ultima.end(), 0);
+            }
+            RotulaLinha<Vizinhanca>(mapa.linha(i), largura, i > r0 ? f.anterior.data() : nullptr,
+                                    f.ultima.data(), f.equivalencias);
+            f.celulas.resize(f.equivalencias.size(), 0);
+            for (std::size_t j = 0; j < largura; j++) f.celulas[f.ultima[j]]++;
+            if (i == r0) f.primeira = f.ultima;
+            if (i == static_cast<std::size_t>(x0)) f.robo = f.ultima[y0];
+        }
+        f.celulas[0] = 0;
+        for (std::uint32_t r = 1; r < f.celulas.size(); r++) {
+            std::uint32_t raiz = f.equivalencias.busca(r);
+            if (raiz == r) continue;
+            f.celulas[raiz] += f.celulas[r];
+            f.celulas[r] = 0;
+        }
+        for (std::size_t j = 0; j < largura; j++) {
+            if (f.primeira[j] != 0) f.primeira[j] = f.equivalencias.busca(f.primeira[j]);
+            if (f.ultima[j] != 0) f.ultima[j] = f.equivalencias.busca(f.ultima[j]);
+            divisas.isola(elemento(k, 0, j));
+            divisas.isola(elemento(k, 1, j));
+        }
+        if (f.robo != 0) f.robo = f.equivalencias.busca(f.robo);
+    });
+
+    // 2. As células de divisa de uma mesma raiz são unidas, e a primeira
+    //    linha de cada faixa com a última da anterior
+    em_paralelo([&](std::size_t k) {
+        FaixaRotulada& f = faixas[k];
+        f.representante.assign(f.celulas.size(), SEM_DIVISA);
+        for (std::size_t lado = 0; lado < 2; lado++) {
+            const std::vector<std::uint32_t>& linha = lado == 0 ? f.primeira : f.ultima;
+            for (std::size_t j = 0; j < largura; j++) {
+                if (linha[j] == 0) continue;
+                std::uint32_t& r = f.representante[linha[j]];
+                if (r == SEM_DIVISA) {
+                    r = elemento(k, lado, j);
+                } else {
+                    divisas.une(elemento(k, lado, j), r);
+                }
+            }
+        }
+        if (k == 0) return;
+        const std::vector<std::uint32_t>& cima = faixas[k - 1].ultima;
+        for (std::size_t j = 0; j < largura; j++) {
+            if (f.primeira[j] == 0) continue;
+            std::size_t j0 = Vizinhanca::diagonais && j > 0 ? j - 1 : j;
+            std::size_t j1 = Vizinhanca::diagonais && j + 1 < largura ? j + 1 : j;
+            for (std::size_t vj = j0; vj <= j1; vj++) {
+                if (cima[vj] != 0) divisas.une(elemento(k, 0, j), elemento(k - 1, 1, vj));
+            }
+        }
+    });
+
+    // 3. Área: a raiz do robô sozinha, se não tocar nenhuma divisa, ou a
+    //    soma das raízes de todas as faixas no mesmo conjunto de divisas
+    std::size_t faixa_robo = 0;
+    while (faixas[faixa_robo].robo == 0) faixa_robo++;
+    const FaixaRotulada& fr = faixas[faixa_robo];
+    if (fr.representante[fr.robo] == SEM_DIVISA) {
+        return static_cast<std::int64_t>(fr.celulas[fr.robo]);
+    }
+    std::uint32_t conjunto = divisas.busca(fr.representante[fr.robo]);
+    std::vector<std::uint64_t> parciais(quantidade, 0);
+    em_paralelo([&](std::size_t k) {
+        FaixaRotulada& f = faixas[k];
+        std::uint64_t total = 0;
+        for (std::uint32_t r = 1; r < f.representante.size(); r++) {
+            if (f.representante[r] != SEM_DIVISA &&
+                divisas.busca(f.representante[r]) == conjunto) {
+                total += f.celulas[r];
+            }
+        }
+        parciais[k] = total;
+    });
+
+    std::uint64_t area = 0;
+    for (std::uint64_t parcial : parciais) area += parcial;
+    return static_cast<std::int64_t>(area);
+}
+
+#endif
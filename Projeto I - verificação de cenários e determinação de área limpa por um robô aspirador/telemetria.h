@@ -0,0 +1,111 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+// Telemetria por cenário, ligada na compilação com -DTELEMETRIA (e, na
+// execução, com --telemetria=ARQUIVO). Sem a macro, TELEMETRIA_CONTA não
+// gera código e os motores ficam exatamente como seriam sem ela.
+#ifdef TELEMETRIA
+#define TELEMETRIA_CONTA(instrucao) instrucao
+#else
+#define TELEMETRIA_CONTA(instrucao)
+#endif
+
+#ifdef TELEMETRIA
+
+#include <chrono>
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <cstdio>  // std::snprintf
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+//! Contadores de um preenchimento, atualizados pelos motores
+struct EstatisticasPreenchimento {
+    std::size_t visitadas = 0;  // células marcadas (ou examinadas) pelo motor
+    std::size_t pico_fila = 0;  // maior ocupação da fronteira / pilha
+    std::size_t passadas = 0;  // varreduras do mapa (motor Bits)
+
+    void zera() { *this = EstatisticasPreenchimento(); }
+    void fila(std::size_t tamanho) {
+        if (tamanho > pico_fila) pico_fila = tamanho;
+    }
+};
+
+//! Medidas de um cenário, escritas como uma linha JSON
+struct Telemetria {
+    std::uint64_t leitura_ns = 0;  // tokenização + verificação (uma só passada)
+    std::uint64_t carga_ns = 0;  // texto de <matriz> para o Grid
+    std::uint64_t preenchimento_ns = 0;
+    std::size_t bytes_alocados = 0;  // pelo operator new, nesta thread
+    EstatisticasPreenchimento preenchimento;
+};
+
+//! Instante atual, em nanossegundos
+inline std::uint64_t AgoraNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//! Bytes pedidos ao operator new pela thread atual (o operator new que
+//! soma aqui é substituído em main.cpp)
+inline std::size_t& BytesAlocadosThread() {
+    thread_local std::size_t bytes = 0;
+    return bytes;
+}
+
+//! CLASSE REGISTRO DE TELEMETRIA
+//! Arquivo de linhas JSON, um objeto por cenário; pode ser usado por
+//! várias threads ao mesmo tempo.
+class RegistroTelemetria {
+ public:
+    //! metodo cria o arquivo 'caminho'
+    bool abre(const std::string& caminho);
+    //! metodo escreve a linha do cenário 'nome'
+    void escreve(std::string_view nome, const Telemetria& t);
+
+ private:
+    std::mutex trava_;
+    std::ofstream arquivo_;
+};
+
+// cria o arquivo
+inline bool RegistroTelemetria::abre(const std::string& caminho) {
+    arquivo_.open(caminho, std::ios::trunc);
+    return arquivo_.is_open();
+}
+
+// uma linha JSON
+inline void RegistroTelemetria::escreve(std::string_view nome, const Telemetria& t) {
+    std::string linha = "{\"cenario\":\"";
+    for (char c : nome) {
+        if (c == '"' || c == '\\') {
+            linha += '\\';
+            linha += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            linha += escape;
+        } else {
+            linha += c;
+        }
+    }
+    linha += "\",\"leitura_ns\":" + std::to_string(t.leitura_ns);
+    linha += ",\"carga_ns\":" + std::to_string(t.carga_ns);
+    linha += ",\"preenchimento_ns\":" + std::to_string(t.preenchimento_ns);
+    linha += ",\"celulas_visitadas\":" + std::to_string(t.preenchimento.visitadas);
+    linha += ",\"pico_fila\":" + std::to_string(t.preenchimento.pico_fila);
+    linha += ",\"passadas\":" + std::to_string(t.preenchimento.passadas);
+    linha += ",\"bytes_alocados\":" + std::to_string(t.bytes_alocados);
+    linha += "}\n";
+
+    std::lock_guard<std::mutex> trava(trava_);
+    arquivo_ << linha;
+}
+
+#endif  // TELEMETRIA
+
+#endif
@@ -0,0 +1,317 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef TOKENIZADOR_XML_H
+#define TOKENIZADOR_XML_H
+
+#include <charconv>  // std::from_chars
+#include <cstddef>  // std::size_t
+#include <cstring>  // std::memchr
+#include <string>
+#include <string_view>
+#include <system_error>  // std::errc
+#include <vector>
+
+//! Identificadores das tags conhecidas do formato de cenários
+enum Tag : int {
+    TAG_DESCONHECIDA = -1,
+    TAG_CENARIOS = 0,
+    TAG_CENARIO,
+    TAG_NOME,
+    TAG_DIMENSOES,
+    TAG_ALTURA,
+    TAG_LARGURA,
+    TAG_ROBO,
+    TAG_X,
+    TAG_Y,
+    TAG_MATRIZ,
+    TAG_ROBOS,
+    TAG_CONECTIVIDADE,
+    NUM_TAGS_CONHECIDAS
+};
+
+//! Tipos de evento produzidos pelo tokenizador
+enum class TipoEvento { Abertura, Fechamento, Fim, Erro };
+
+//! Evento do tokenizador: uma tag e o texto que vem logo depois dela
+struct EventoXML {
+    TipoEvento tipo;
+    int tag;  // identificador da tag (TAG_DESCONHECIDA se não for conhecida)
+    std::string_view nome;  // nome da tag, sem '<', '/' e '>'
+    std::string_view valor;  // texto entre o '>' desta tag e o próximo '<'
+    std::size_t posicao;  // posição do '<' no texto
+};
+
+//! Retorna o identificador de uma tag conhecida (hash perfeito)
+int identifica_tag(std::string_view nome);
+
+//! Converte o texto de 'valor' para inteiro, ignorando espaços ao redor
+bool le_inteiro(std::string_view valor, std::size_t& saida);
+
+//! CLASSE TOKENIZADOR XML
+//! Tokenizador "pull": cada chamada de proximo() devolve a próxima tag do
+//! texto. As buscas por '<' e '>' usam memchr e os campos do evento são
+//! visões sobre o texto original, então nenhum caractere é copiado.
+class TokenizadorXML {
+ public:
+    //! construtor: começa a ler 'texto' a partir de 'pos'
+    explicit TokenizadorXML(std::string_view texto, std::size_t pos = 0);
+    //! metodo le o proximo evento; retorna false no fim do texto ou em erro
+    bool proximo(EventoXML& evento);
+    //! metodo retorna a posição logo depois da última tag lida
+    std::size_t posicao() const;
+
+ private:
+    std::string_view texto_;
+    std::size_t pos_;
+    std::size_t proximo_abre_;  // '<' já encontrado ao delimitar o último valor
+};
+
+//! CLASSE TABELA DE TAGS
+//! Associa cada nome de tag a um inteiro pequeno. As tags conhecidas usam
+//! os valores de Tag; as demais recebem identificadores a partir de
+//! NUM_TAGS_CONHECIDAS, guardados em uma tabela de espalhamento aberta.
+//! Só há alocação na primeira vez que um nome desconhecido aparece.
+class TabelaTags {
+ public:
+    //! construtor
+    TabelaTags();
+    //! metodo retorna o identificador do nome (internando se for novo)
+    int id(std::string_view nome, int tag_conhecida);
+    //! metodo retorna quantos nomes desconhecidos foram internados
+    std::size_t size() const;
+
+ private:
+    void cresce();
+    std::size_t procura(std::string_view nome) const;
+
+    std::vector<std::string> nomes_;  // nome de cada posição ocupada
+    std::vector<int> ids_;  // -1 marca posição livre
+    std::size_t ocupados_;
+
+    static const auto DEFAULT_SIZE = 16u;
+};
+
+//! CLASSE VERIFICADOR DE ANINHAMENTO
+//! Pilha de identificadores de tags (ver TabelaTags) que cresce conforme a
+//! profundidade, sem limite fixo. Recebe os eventos do tokenizador em
+//! ordem; pode ser alimentado por vários trechos do mesmo documento.
+class VerificadorAninhamento {
+ public:
+    //! construtor
+    VerificadorAninhamento();
+    //! metodo registra a tag do evento e coloca seu identificador em 'id';
+    //! retorna false se ela fecha uma tag que não é a última aberta
+    bool processa(const EventoXML& evento, int& id);
+    //! metodo verifica se todas as tags abertas foram fechadas
+    bool completo() const;
+
+ private:
+    TabelaTags tabela_;
+    std::vector<int> pilha_;
+};
+
+// identifica tag conhecida
+// A função (tamanho + primeiro + último caractere) % 32 não tem colisões
+// entre os doze nomes do formato, então basta uma comparação por tag.
+inline int identifica_tag(std::string_view nome) {
+    static const std::string_view nomes[NUM_TAGS_CONHECIDAS] = {
+        "cenarios", "cenario", "nome", "dimensoes", "altura",
+        "largura", "robo", "x", "y", "matriz", "robos", "conectividade"
+    };
+    static const signed char posicoes[32] = {
+        TAG_DIMENSOES, -1, -1, -1, -1, TAG_ROBO, -1, -1,
+        TAG_ALTURA, -1, TAG_ROBOS, -1, -1, TAG_MATRIZ, -1, -1,
+        -1, TAG_X, -1, TAG_Y, TAG_LARGURA, TAG_CONECTIVIDADE, -1, TAG_NOME,
+        -1, TAG_CENARIO, -1, -1, -1, -1, TAG_CENARIOS, -1
+    };
+    if (nome.empty()) return TAG_DESCONHECIDA;
+    unsigned h = static_cast<unsigned>(nome.size()) +
+                 static_cast<unsigned char>(nome.front()) +
+                 static_cast<unsigned char>(nome.back());
+    int tag = posicoes[h & 31u];
+    if (tag >= 0 && nomes[tag] == nome) return tag;
+    return TAG_DESCONHECIDA;
+}
+
+// converte inteiro no próprio texto, sem string temporária
+inline bool le_inteiro(std::string_view valor, std::size_t& saida) {
+    const char* inicio = valor.data();
+    const char* fim = inicio + valor.size();
+    while (inicio < fim && (*inicio == ' ' || *inicio == '\n' ||
+                            *inicio == '\r' || *inicio == '\t')) {
+        inicio++;
+    }
+    auto resultado = std::from_chars(inicio, fim, saida);
+    return resultado.ec == std::errc();
+}
+
+// construtor
+inline TokenizadorXML::TokenizadorXML(std::string_view texto, std::size_t pos) {
+    texto_ = texto;
+    pos_ = pos;
+    proximo_abre_ = std::string_view::npos;
+}
+
+// lê o próximo evento
+inline bool TokenizadorXML::proximo(EventoXML& evento) {
+    const char* base = texto_.data();
+    std::size_t n = texto_.size();
+
+    evento.tag = TAG_DESCONHECIDA;
+    evento.nome = std::string_view();
+    evento.valor = std::string_view();
+
+    if (pos_ >= n) {
+        evento.tipo = TipoEvento::Fim;
+        evento.posicao = n;
+        return false;
+    }
+
+    // Procura o início da próxima tag (reaproveita a busca feita para o
+    // valor do evento anterior, assim cada byte é examinado uma só vez)
+    const char* abre;
+    if (proximo_abre_ != std::string_view::npos && proximo_abre_ >= pos_) {
+        abre = proximo_abre_ < n ? base + proximo_abre_ : nullptr;
+    } else {
+        abre = static_cast<const char*>(
+            std::memchr(base + pos_, '<', n - pos_));
+    }
+    if (abre == nullptr) {
+        pos_ = n;
+        evento.tipo = TipoEvento::Fim;
+        evento.posicao = n;
+        return false;
+    }
+    std::size_t i = abre - base;
+    evento.posicao = i;
+
+    // Procura o fim da tag
+    const char* fecha = static_cast<const char*>(
+        std::memchr(abre + 1, '>', n - i - 1));
+    if (fecha == nullptr) {
+        // Erro: tag não fechada
+        pos_ = n;
+        evento.tipo = TipoEvento::Erro;
+        return false;
+    }
+    std::size_t j = fecha - base;
+    std::string_view nome = texto_.substr(i + 1, j - i - 1);
+
+    // Erro: um '<' dentro da tag
+    if (std::memchr(nome.data(), '<', nome.size()) != nullptr) {
+        pos_ = n;
+        evento.tipo = TipoEvento::Erro;
+        return false;
+    }
+
+    if (!nome.empty() && nome[0] == '/') {
+        evento.tipo = TipoEvento::Fechamento;
+        nome.remove_prefix(1);
+    } else {
+        evento.tipo = TipoEvento::Abertura;
+    }
+    evento.nome = nome;
+    evento.tag = identifica_tag(nome);
+
+    // O valor vai até o próximo '<' (ou até o fim do texto)
+    pos_ = j + 1;
+    const char* proximo_abre = static_cast<const char*>(
+        std::memchr(base + pos_, '<', n - pos_));
+    std::size_t fim_valor = proximo_abre ? proximo_abre - base : n;
+    proximo_abre_ = fim_valor;
+    evento.valor = texto_.substr(pos_, fim_valor - pos_);
+    return true;
+}
+
+// posição atual
+inline std::size_t TokenizadorXML::posicao() const {
+    return pos_;
+}
+
+// construtor
+inline TabelaTags::TabelaTags() {
+    nomes_.resize(DEFAULT_SIZE);
+    ids_.assign(DEFAULT_SIZE, -1);
+    ocupados_ = 0;
+}
+
+// identificador de um nome de tag
+inline int TabelaTags::id(std::string_view nome, int tag_conhecida) {
+    if (tag_conhecida != TAG_DESCONHECIDA) return tag_conhecida;
+
+    std::size_t i = procura(nome);
+    if (ids_[i] >= 0) return ids_[i];
+
+    // Nome novo: mantém a tabela no máximo meio cheia
+    if (2 * (ocupados_ + 1) > ids_.size()) {
+        cresce();
+        i = procura(nome);
+    }
+    nomes_[i] = std::string(nome);
+    ids_[i] = NUM_TAGS_CONHECIDAS + static_cast<int>(ocupados_);
+    ocupados_++;
+    return ids_[i];
+}
+
+// quantidade de nomes internados
+inline std::size_t TabelaTags::size() const {
+    return ocupados_;
+}
+
+// posição do nome na tabela, ou a posição livre onde ele entraria
+inline std::size_t TabelaTags::procura(std::string_view nome) const {
+    std::size_t h = 14695981039346656037ull;  // FNV-1a
+    for (char c : nome) {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    std::size_t mascara = ids_.size() - 1;
+    std::size_t i = h & mascara;
+    while (ids_[i] >= 0 && nomes_[i] != nome) {
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+// dobra a capacidade e reinsere os nomes
+inline void TabelaTags::cresce() {
+    std::vector<std::string> nomes_antigos;
+    std::vector<int> ids_antigos;
+    nomes_antigos.swap(nomes_);
+    ids_antigos.swap(ids_);
+    nomes_.resize(2 * nomes_antigos.size());
+    ids_.assign(2 * ids_antigos.size(), -1);
+    for (std::size_t j = 0; j < ids_antigos.size(); j++) {
+        if (ids_antigos[j] < 0) continue;
+        std::size_t i = procura(nomes_antigos[j]);
+        nomes_[i].swap(nomes_antigos[j]);
+        ids_[i] = ids_antigos[j];
+    }
+}
+
+// construtor
+inline VerificadorAninhamento::VerificadorAninhamento() {
+    pilha_.reserve(16);
+}
+
+// registra uma tag
+inline bool VerificadorAninhamento::processa(const EventoXML& evento, int& id) {
+    id = tabela_.id(evento.nome, evento.tag);
+    if (evento.tipo == TipoEvento::Fechamento) {
+        if (pilha_.empty() || pilha_.back() != id) {
+            // Se a pilha não conter a tag de abertura
+            // Ou se tentamos fechar uma tag que não é a esperada
+            return false;  // Erro de aninhamento
+        }
+        pilha_.pop_back();
+    } else {
+        // É uma tag de abertura
+        pilha_.push_back(id);
+    }
+    return true;
+}
+
+// todas fechadas
+inline bool VerificadorAninhamento::completo() const {
+    return pilha_.empty();
+}
+
+#endif
@@ -0,0 +1,162 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef UNIAO_BUSCA_H
+#define UNIAO_BUSCA_H
+
+#include <atomic>
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint32_t
+#include <memory>  // std::unique_ptr
+#include <vector>
+
+//! CLASSE UNIAO-BUSCA
+//! Conjuntos disjuntos com união por tamanho e compressão de caminho
+//! (por "halving": cada nó visitado passa a apontar para o avô).
+class UniaoBusca {
+ public:
+    //! construtor padrao (sem conjuntos)
+    UniaoBusca();
+    //! metodo remove todos os conjuntos, mantendo a memória alocada
+    void clear();
+    //! metodo cria um conjunto unitário e retorna seu identificador
+    std::uint32_t cria();
+    //! metodo retorna a raiz do conjunto de x
+    std::uint32_t busca(std::uint32_t x);
+    //! metodo une os conjuntos de a e b e retorna a nova raiz
+    std::uint32_t une(std::uint32_t a, std::uint32_t b);
+    //! metodo retorna quantos elementos tem o conjunto de x
+    std::uint32_t tamanho(std::uint32_t x);
+    //! metodo retorna quantos elementos foram criados
+    std::size_t size() const;
+
+ private:
+    std::vector<std::uint32_t> pai_;
+    std::vector<std::uint32_t> tamanho_;  // válido apenas nas raízes
+};
+
+//! CLASSE UNIAO-BUSCA CONCORRENTE
+//! União-busca sobre um número fixo de elementos, segura para várias
+//! threads ao mesmo tempo (sem travas). A ligação entre raízes é feita com
+//! compare-and-swap, sempre da raiz de maior índice para a de menor, e a
+//! compressão de caminho troca pais por avós com compare-and-swap também:
+//! qualquer ancestral continua sendo um pai válido, então as corridas entre
+//! threads só atrasam a compressão, nunca a invalidam.
+class UniaoBuscaConcorrente {
+ public:
+    //! construtor padrao (sem elementos)
+    UniaoBuscaConcorrente();
+    //! metodo prepara 'n' elementos (sem inicializá-los)
+    void redimensiona(std::size_t n);
+    //! metodo torna x um conjunto unitário (antes de ser unido a outros)
+    void isola(std::uint32_t x);
+    //! metodo retorna a raiz do conjunto de x
+    std::uint32_t busca(std::uint32_t x);
+    //! metodo une os conjuntos de a e b
+    void une(std::uint32_t a, std::uint32_t b);
+
+ private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> pai_;
+    std::size_t tamanho_;
+};
+
+// construtor padrao
+inline UniaoBusca::UniaoBusca() {}
+
+// limpa
+inline void UniaoBusca::clear() {
+    pai_.clear();
+    tamanho_.clear();
+}
+
+// cria conjunto unitário
+inline std::uint32_t UniaoBusca::cria() {
+    std::uint32_t id = static_cast<std::uint32_t>(pai_.size());
+    pai_.push_back(id);
+    tamanho_.push_back(1);
+    return id;
+}
+
+// raiz do conjunto
+inline std::uint32_t UniaoBusca::busca(std::uint32_t x) {
+    while (pai_[x] != x) {
+        pai_[x] = pai_[pai_[x]];
+        x = pai_[x];
+    }
+    return x;
+}
+
+// une dois conjuntos (o menor passa a apontar para o maior)
+inline std::uint32_t UniaoBusca::une(std::uint32_t a, std::uint32_t b) {
+    a = busca(a);
+    b = busca(b);
+    if (a == b) return a;
+    if (tamanho_[a] < tamanho_[b]) {
+        std::uint32_t t = a;
+        a = b;
+        b = t;
+    }
+    pai_[b] = a;
+    tamanho_[a] += tamanho_[b];
+    return a;
+}
+
+// tamanho do conjunto
+inline std::uint32_t UniaoBusca::tamanho(std::uint32_t x) {
+    return tamanho_[busca(x)];
+}
+
+// quantidade de elementos
+inline std::size_t UniaoBusca::size() const {
+    return pai_.size();
+}
+
+// construtor padrao
+inline UniaoBuscaConcorrente::UniaoBuscaConcorrente() {
+    tamanho_ = 0;
+}
+
+// prepara n elementos
+inline void UniaoBuscaConcorrente::redimensiona(std::size_t n) {
+    if (n > tamanho_) {
+        pai_.reset(new std::atomic<std::uint32_t>[n]);
+        tamanho_ = n;
+    }
+}
+
+// conjunto unitário
+inline void UniaoBuscaConcorrente::isola(std::uint32_t x) {
+    pai_[x].store(x, std::memory_order_relaxed);
+}
+
+// raiz do conjunto
+inline std::uint32_t UniaoBuscaConcorrente::busca(std::uint32_t x) {
+    while (true) {
+        std::uint32_t p = pai_[x].load(std::memory_order_acquire);
+        if (p == x) return x;
+        std::uint32_t avo = pai_[p].load(std::memory_order_acquire);
+        if (avo != p) {
+            pai_[x].compare_exchange_weak(p, avo, std::memory_order_acq_rel);
+        }
+        x = avo;
+    }
+}
+
+// une dois conjuntos
+inline void UniaoBuscaConcorrente::une(std::uint32_t a, std::uint32_t b) {
+    while (true) {
+        a = busca(a);
+        b = busca(b);
+        if (a == b) return;
+        if (a < b) {
+            std::uint32_t t = a;
+            a = b;
+            b = t;
+        }
+        // 'a' ainda é raiz? então passa a apontar para 'b'
+        std::uint32_t esperado = a;
+        if (pai_[a].compare_exchange_strong(esperado, b, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright [2024] <Juliana Miranda Bosio>
+#ifndef VIZINHANCA_H
+#define VIZINHANCA_H
+
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <utility>  // std::index_sequence
+
+// Políticas de vizinhança usadas como parâmetro de template pelos motores:
+// como os deslocamentos são constexpr, o laço sobre os vizinhos é
+// desenrolado pelo compilador (ParaCadaVizinho) e cada motor é gerado
+// separadamente para 4 e para 8 vizinhos, sem teste em tempo de execução.
+
+//! Vizinhança-4: cima, baixo, esquerda e direita
+struct Vizinhanca4 {
+    static constexpr int quantidade = 4;
+    static constexpr bool diagonais = false;
+    static constexpr int dx[4] = {-1, 1, 0, 0};  // Movimentos Verticais
+    static constexpr int dy[4] = {0, 0, -1, 1};  // Movimentos Horizontais
+};
+
+//! Vizinhança-8: também as quatro diagonais
+struct Vizinhanca8 {
+    static constexpr int quantidade = 8;
+    static constexpr bool diagonais = true;
+    static constexpr int dx[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static constexpr int dy[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+};
+
+//! Converte o valor de <conectividade> (4 ou 8); outros valores ficam em 4
+inline int conectividade_de_valor(std::size_t valor) {
+    return valor == 8 ? 8 : 4;
+}
+
+template <typename Vizinhanca, typename Funcao, std::size_t... I>
+inline void ParaCadaVizinho(Funcao& funcao, std::index_sequence<I...>) {
+    (funcao(Vizinhanca::dx[I], Vizinhanca::dy[I]), ...);
+}
+
+//! Chama funcao(dx, dy) para cada vizinho, com o laço desenrolado
+template <typename Vizinhanca, typename Funcao>
+inline void ParaCadaVizinho(Funcao funcao) {
+    ParaCadaVizinho<Vizinhanca>(funcao,
+                                std::make_index_sequence<Vizinhanca::quantidade>());
+}
+
+#endif